@@ -31,52 +31,147 @@
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 #include "G4Types.hh"
+#include "G4Version.hh"
+#include "G4Threading.hh"
 
 #ifdef G4MULTITHREADED
-#include "G4MTRunManager.hh"
-#else
-#include "G4RunManager.hh"
+#include "ChunkedRunManager.hh"
+#include "WorkerThreadInitialization.hh"
+#if G4VERSION_NUMBER >= 1070
+#include "G4RunManagerFactory.hh"
+#endif
 #endif
+#include "G4RunManager.hh"
+#include "G4AdjointSimManager.hh"
 
 #include "G4UImanager.hh"
 #include "Randomize.hh"
 
 #include "DetectorConstruction.hh"
 #include "PhysicsList.hh"
+#include "ScoringWorldPhysics.hh"
+#include "ImportanceBiasingPhysics.hh"
+#include "WeightWindowPhysics.hh"
+#include "ExpTransformPhysics.hh"
+#include "AdjointPhysics.hh"
 #include "ActionInitialization.hh"
 #include "SteppingVerbose.hh"
 
 #include "G4UIExecutive.hh"
 #include "G4VisExecutive.hh"
 
+#include <cstdlib>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace {
+  // option from the environment, overridden by the command line
+  long GetEnv(const char* name, long value)
+  {
+    const char* var = std::getenv(name);
+    return var ? std::atol(var) : value;
+  }
+}
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 int main(int argc,char** argv) {
 
-  //detect interactive mode (if no arguments) and define UI session
+  //options, then the macro file; the numbers and the run manager can
+  //also be set in the environment
+  //  -adjoint    : reverse Monte Carlo of the gammas (/adjoint/start_run),
+  //                sequential
+  //  -tasking    : tasking run manager, Geant4 >= 10.7
+  //                (MONITOR_RUN_MANAGER=tasking)
+  //  -t <n>      : number of threads (MONITOR_THREADS; default all cores)
+  //  -chunk <n>  : most events handed to a thread at once, the chunks
+  //                shrinking toward the end of the run
+  //                (MONITOR_EVENT_MODULO; 0: Geant4 default)
+  //  -fixedChunk : chunks of -chunk events up to the end of the run
+  //  -seed <n>   : seed of the master engine (MONITOR_SEED)
+  //  -pin <p>    : thread affinity, compact|scatter|cpu list (0-7,16-23),
+  //                with merges per NUMA node; MT run manager (MONITOR_PIN)
+  const char* manager = std::getenv("MONITOR_RUN_MANAGER");
+  G4bool adjoint = false;
+  G4bool tasking = manager && G4String(manager) == "tasking";
+  G4bool adaptive = true;
+  G4int nbThreads = GetEnv("MONITOR_THREADS", 0);
+  G4int chunk = GetEnv("MONITOR_EVENT_MODULO", 0);
+  long seed = GetEnv("MONITOR_SEED", 0);
+  const char* pinEnv = std::getenv("MONITOR_PIN");
+  G4String pin = pinEnv ? pinEnv : "";
+  G4String macro;
+  for (G4int i=1; i<argc; ++i) {
+    G4String arg = argv[i];
+    if      (arg == "-adjoint")    adjoint = true;
+    else if (arg == "-tasking")    tasking = true;
+    else if (arg == "-fixedChunk") adaptive = false;
+    else if (arg == "-t"     && i+1 < argc) nbThreads = std::atoi(argv[++i]);
+    else if (arg == "-chunk" && i+1 < argc) chunk = std::atoi(argv[++i]);
+    else if (arg == "-seed"  && i+1 < argc) seed = std::atol(argv[++i]);
+    else if (arg == "-pin"   && i+1 < argc) pin = argv[++i];
+    else macro = arg;
+  }
+  if (nbThreads <= 0) nbThreads = G4Threading::G4GetNumberOfCores();
+
+  //detect interactive mode (if no macro) and define UI session
   G4UIExecutive* ui = nullptr;
-  if (argc == 1) ui = new G4UIExecutive(argc,argv);
+  if (macro.empty()) ui = new G4UIExecutive(argc,argv);
 
-  //choose the Random engine
+  //choose the Random engine; the master seeds the threads
   G4Random::setTheEngine(new CLHEP::RanecuEngine);
+  if (seed > 0) G4Random::setTheSeed(seed);
 
-  //construct the default run manager
+  //construct the default run manager; the adjoint simulation of this
+  //Geant4 version runs in sequential mode only
+  G4RunManager* runManager = nullptr;
 #ifdef G4MULTITHREADED
-  G4MTRunManager* runManager = new G4MTRunManager;
-  runManager->SetNumberOfThreads(G4Threading::G4GetNumberOfCores());
+#if G4VERSION_NUMBER >= 1070
+  if (!adjoint && tasking) {
+    //task-based: the events are pulled from a task queue, by chunks of
+    //the event modulo
+    runManager = G4RunManagerFactory::CreateRunManager(G4RunManagerType::Tasking);
+    runManager->SetNumberOfThreads(nbThreads);
+    G4MTRunManager* taskRunManager = dynamic_cast<G4MTRunManager*>(runManager);
+    if (taskRunManager && chunk > 0) taskRunManager->SetEventModulo(chunk);
+  }
 #else
-  //my Verbose output class
-  G4VSteppingVerbose::SetInstance(new SteppingVerbose);
-  G4RunManager* runManager = new G4RunManager;
+  if (tasking) {
+    G4cout << "\n--> warning from main : the tasking run manager needs"
+           << " Geant4 10.7, using the MT one" << G4endl;
+  }
 #endif
+  if (!adjoint && !runManager) {
+    ChunkedRunManager* mtRunManager = new ChunkedRunManager;
+    mtRunManager->SetNumberOfThreads(nbThreads);
+    if (chunk > 0) mtRunManager->SetEventModulo(chunk);
+    mtRunManager->SetAdaptive(adaptive);
+    mtRunManager->SetUserInitialization(
+      new WorkerThreadInitialization(pin, nbThreads));
+    runManager = mtRunManager;
+  }
+#endif
+  if (!runManager) {
+    //my Verbose output class
+    G4VSteppingVerbose::SetInstance(new SteppingVerbose);
+    runManager = new G4RunManager;
+  }
 
   //set mandatory initialization classes
   DetectorConstruction* det= new DetectorConstruction;
   runManager->SetUserInitialization(det);
 
   PhysicsList* phys = new PhysicsList;
+  phys->RegisterPhysics(new ScoringWorldPhysics(det->GetScoringWorld()));
+  phys->RegisterPhysics(new ImportanceBiasingPhysics(det->GetImportanceWorld()));
+  phys->RegisterPhysics(new WeightWindowPhysics(det->GetWeightWindowWorld()));
+  if (adjoint) phys->RegisterPhysics(new AdjointPhysics);
+  phys->RegisterPhysics(new ExpTransformPhysics);     //last: wraps the others
   runManager->SetUserInitialization(phys);
-  runManager->SetUserInitialization(new ActionInitialization(det));
+  runManager->SetUserInitialization(new ActionInitialization(det, adjoint));
+
+  //the /adjoint/ commands
+  if (adjoint) G4AdjointSimManager::GetInstance();
 
   //initialize visualization
   G4VisManager* visManager = nullptr;
@@ -96,8 +191,7 @@ int main(int argc,char** argv) {
   else  {
    //batch mode
    G4String command = "/control/execute ";
-   G4String fileName = argv[1];
-   UImanager->ApplyCommand(command+fileName);
+   UImanager->ApplyCommand(command+macro);
   }
 
   //job termination
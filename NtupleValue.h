@@ -0,0 +1,58 @@
+/*
+NtupleValue reads one column of the nFlux/gFlux ntuples as a double,
+whatever the schema selected with /testhadr/output/schema :
+  double  : Double_t columns, read as they are
+  float   : Float_t columns
+  compact : Int_t fixed-point positions and log-quantized energies,
+            decoded with CompactSchema.hh
+It is used like a TTreeReaderValue<Double_t> :
+  NtupleValue x(reader, "x");  ...  while (reader.Next()) h->Fill(*x);
+*/
+
+#ifndef NtupleValue_h
+#define NtupleValue_h 1
+
+#include "TTreeReader.h"
+#include "TTreeReaderValue.h"
+#include "TLeaf.h"
+#include "TString.h"
+
+#include "CompactSchema.hh"
+
+class NtupleValue
+{
+  public:
+    NtupleValue(TTreeReader& reader, const char* column)
+      : fDouble(0), fFloat(0), fInt(0)
+    {
+      TString name(column);
+      fIsEnergy = (name == "KE" || name == "E");
+
+      TLeaf* leaf = reader.GetTree() ? reader.GetTree()->GetLeaf(column) : 0;
+      TString type = leaf ? leaf->GetTypeName() : "Double_t";
+      if      (type == "Float_t") fFloat = new TTreeReaderValue<Float_t>(reader, column);
+      else if (type == "Int_t")   fInt   = new TTreeReaderValue<Int_t>(reader, column);
+      else                        fDouble = new TTreeReaderValue<Double_t>(reader, column);
+    }
+
+    ~NtupleValue() { delete fDouble; delete fFloat; delete fInt; }
+
+    double operator*()
+    {
+      if (fDouble) return **fDouble;
+      if (fFloat)  return **fFloat;
+      return fIsEnergy ? CompactSchema::DecodeEnergy(**fInt)
+                       : CompactSchema::DecodePosition(**fInt);
+    }
+
+  private:
+    NtupleValue(const NtupleValue&);
+    NtupleValue& operator=(const NtupleValue&);
+
+    TTreeReaderValue<Double_t>* fDouble;
+    TTreeReaderValue<Float_t>*  fFloat;
+    TTreeReaderValue<Int_t>*    fInt;
+    bool                        fIsEnergy;
+};
+
+#endif
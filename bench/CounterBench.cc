@@ -0,0 +1,125 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file CounterBench.cc
+/// \brief Per-step cost of the process counter of Run
+//
+// Compares the former std::map<G4String,G4int> counter, which copies the
+// process name on every step, with the dense PointerIndex counter.
+// Usage: counterBench [nSteps]
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "DenseCounter.hh"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+  // stands for a G4VProcess: only its address and name are used
+  struct Process { std::string fName; };
+
+  const char* kProcessNames[] = {
+    "Transportation", "hadElastic", "neutronInelastic", "nCapture",
+    "nFission", "compt", "phot", "conv", "Rayl", "eIoni", "eBrem", "msc",
+    "annihil", "ionIoni", "hIoni", "CoulombScat"
+  };
+
+  double Seconds(std::chrono::steady_clock::time_point start)
+  {
+    return std::chrono::duration<double>(
+             std::chrono::steady_clock::now() - start).count();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int main(int argc, char** argv)
+{
+  long nSteps = (argc > 1) ? std::atol(argv[1]) : 20000000L;
+
+  const size_t nProc = sizeof(kProcessNames)/sizeof(kProcessNames[0]);
+  std::vector<Process> processes(nProc);
+  for (size_t i=0; i<nProc; ++i) processes[i].fName = kProcessNames[i];
+
+  // step sequence dominated by transportation and elastic scattering,
+  // as in the thermalization of neutrons in the water tank
+  std::mt19937 engine(12345);
+  std::discrete_distribution<int> pick({40, 35, 5, 3, 1, 6, 2, 1, 1, 2, 1, 1,
+                                        0.5, 0.5, 0.5, 0.5});
+  std::vector<const Process*> steps(1 << 20);
+  for (size_t i=0; i<steps.size(); ++i) steps[i] = &processes[pick(engine)];
+  const size_t mask = steps.size() - 1;
+
+  // before: std::map keyed by a copy of the process name
+  std::map<std::string,int> mapCounter;
+  auto start = std::chrono::steady_clock::now();
+  for (long i=0; i<nSteps; ++i) {
+    std::string procName = steps[i & mask]->fName;
+    std::map<std::string,int>::iterator it = mapCounter.find(procName);
+    if (it == mapCounter.end()) mapCounter[procName] = 1;
+    else                        mapCounter[procName]++;
+  }
+  double tMap = Seconds(start);
+
+  // after: dense IDs through a per-thread pointer index
+  NameRegistry registry;
+  PointerIndex index;
+  std::vector<int> denseCounter;
+  start = std::chrono::steady_clock::now();
+  for (long i=0; i<nSteps; ++i) {
+    const Process* process = steps[i & mask];
+    int id = index.Find(process);
+    if (id < 0) {
+      id = registry.Register(process->fName);
+      index.Insert(process, id);
+      if (id >= int(denseCounter.size())) denseCounter.resize(id+1, 0);
+    }
+    denseCounter[id]++;
+  }
+  double tDense = Seconds(start);
+
+  // both counters must agree
+  long nbDiff = 0;
+  for (int id=0; id<registry.GetSize(); ++id) {
+    if (mapCounter[registry.GetName(id)] != denseCounter[id]) ++nbDiff;
+  }
+
+  std::printf(" steps                : %ld\n", nSteps);
+  std::printf(" std::map<name> count : %8.2f ns/step\n", 1.e9*tMap/nSteps);
+  std::printf(" dense count          : %8.2f ns/step\n", 1.e9*tDense/nSteps);
+  std::printf(" speedup              : %8.1f\n", tMap/tDense);
+  std::printf(" mismatched counters  : %ld\n", nbDiff);
+  return nbDiff ? 1 : 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,121 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file DoseBench.cc
+/// \brief Cost of a fluence-to-dose lookup in FluenceToDose
+//
+// Compares the log-log interpolation with a binary search in the ICRP-74
+// neutron table, as a ROOT macro would do it per entry, with the
+// precomputed log-grid lookup, one by one and by batches.
+// Usage: doseBench [nLookups]
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "FluenceToDose.hh"
+#include "CrossingBuffer.hh"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace {
+
+  double Seconds(std::chrono::steady_clock::time_point start)
+  {
+    return std::chrono::duration<double>(
+             std::chrono::steady_clock::now() - start).count();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int main(int argc, char** argv)
+{
+  long nLookups = (argc > 1) ? std::atol(argv[1]) : 20000000L;
+  const int particle = CrossingRecord::kNeutron;
+
+  // neutron energies spread from thermal to the DD line, log-uniform
+  std::mt19937 engine(12345);
+  std::uniform_real_distribution<double> logE(-9., std::log10(2.5));
+  std::vector<double> energy(1 << 16), coefficient(energy.size());
+  for (size_t i=0; i<energy.size(); ++i) energy[i] = std::pow(10., logE(engine));
+  const size_t mask = energy.size() - 1;
+
+  std::vector<G4double> tableE, tableH;
+  FluenceToDose::GetICRP74(particle, tableE, tableH);
+  FluenceToDose dose;
+
+  // before: binary search and log-log interpolation per lookup
+  double sumSearch = 0.;
+  auto start = std::chrono::steady_clock::now();
+  for (long i=0; i<nLookups; ++i) {
+    sumSearch += FluenceToDose::Interpolate(tableE, tableH, energy[i & mask]);
+  }
+  double tSearch = Seconds(start);
+
+  // after: log-grid lookup, one by one
+  double sumGrid = 0.;
+  start = std::chrono::steady_clock::now();
+  for (long i=0; i<nLookups; ++i) {
+    sumGrid += dose.GetCoefficient(particle, energy[i & mask]);
+  }
+  double tGrid = Seconds(start);
+
+  // after: log-grid lookup, by batches
+  double sumBatch = 0.;
+  long nBatches = nLookups/long(energy.size());
+  start = std::chrono::steady_clock::now();
+  for (long b=0; b<nBatches; ++b) {
+    dose.Convert(particle, energy.data(), coefficient.data(), energy.size());
+    sumBatch += coefficient[b & mask];
+  }
+  double tBatch = Seconds(start);
+
+  // largest deviation of the grid from the table interpolation
+  double maxDev = 0.;
+  for (size_t i=0; i<energy.size(); ++i) {
+    double exact = FluenceToDose::Interpolate(tableE, tableH, energy[i]);
+    double dev = std::fabs(dose.GetCoefficient(particle, energy[i])/exact - 1.);
+    if (dev > maxDev) maxDev = dev;
+  }
+
+  long nBatchLookups = nBatches*long(energy.size());
+  std::printf(" lookups              : %ld\n", nLookups);
+  std::printf(" search + log-log     : %8.2f ns/lookup\n", 1.e9*tSearch/nLookups);
+  std::printf(" log-grid             : %8.2f ns/lookup\n", 1.e9*tGrid/nLookups);
+  if (nBatchLookups > 0) {
+    std::printf(" log-grid, batches    : %8.2f ns/lookup\n",
+                1.e9*tBatch/nBatchLookups);
+  }
+  std::printf(" max deviation        : %8.2e\n", maxDev);
+  std::printf(" (checksums %g %g %g)\n", sumSearch, sumGrid, sumBatch);
+  return (maxDev < 0.01) ? 0 : 1;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,52 @@
+#!/bin/sh
+#
+# Figure of merit of the lab-wall doses, analog and with the exponential
+# transform in the tank (/testhadr/bias/exp/), for several side-wall
+# thicknesses (/testhadr/det/setWallThickness).
+#
+# Usage (from the build directory):
+#   ../bench/expTransformFom.sh [nEvents] [stretch] [thicknesses in cm]
+#   FACE=East ../bench/expTransformFom.sh 100000 0.6 "30 45 60 75"
+#
+# The FOM = 1/(R^2 T) of the chosen wall face (default North) is taken from
+# the end-of-run printout of SurfaceTally; speedup = FOM(exp)/FOM(analog).
+#
+nEvents=${1:-100000}
+stretch=${2:-0.6}
+thicknesses=${3:-"30 45 60"}
+face=${FACE:-North}
+monitor=${MONITOR:-./Monitor}
+
+fom() {
+  awk -v p=$1 -v f=$2: '$1 == p && $2 == f {
+                          for (i=3; i<NF; ++i) if ($i == "FOM") print $(i+2) }' $3
+}
+
+printf "%10s %8s %14s %14s\n" "wall [cm]" mode "neutron FOM" "gamma FOM"
+for t in $thicknesses; do
+  for p in 0 $stretch; do
+    dir=$(mktemp -d)
+    cat > $dir/bench.mac <<EOM
+/control/execute analysis.mac
+/testhadr/tally/surface true
+/testhadr/det/setWallThickness $t cm
+/testhadr/bias/exp/stretch neutron $p
+/testhadr/bias/exp/stretch gamma $p
+/analysis/setFileName $dir/bench
+/run/initialize
+/run/beamOn $nEvents
+EOM
+    $monitor $dir/bench.mac > $dir/log 2>&1
+    if [ $p = 0 ]; then mode=analog; else mode="p=$p"; fi
+    n=$(fom neutron $face $dir/log); g=$(fom gamma $face $dir/log)
+    printf "%10s %8s %14s %14s\n" $t "$mode" "${n:-none}" "${g:-none}"
+    if [ $p = 0 ]; then n0=$n; g0=$g
+    else
+      awk -v n=$n -v n0=$n0 -v g=$g -v g0=$g0 'BEGIN {
+            printf "%10s %8s %14s %14s\n", "", "speedup",
+                   (n0 > 0) ? sprintf("%.3g", n/n0) : "-",
+                   (g0 > 0) ? sprintf("%.3g", g/g0) : "-" }'
+    fi
+    rm -rf $dir
+  done
+done
@@ -0,0 +1,39 @@
+#!/bin/sh
+#
+# End-of-run tail of the event loop with fixed event-modulo chunks and
+# with the adaptive chunks of ChunkedRunManager, for several thread counts.
+#
+# Usage (from the build directory):
+#   ../bench/loadBalance.sh [nEvents] [chunk] [thread counts]
+#   ../bench/loadBalance.sh 10000000 2000 "8 16 32"
+#
+# "tail" is the spread of the times the threads ran out of events, as a
+# fraction of the run (the "Load balance" line of ChunkedRunManager);
+# "wall" is the elapsed time of the whole job.
+#
+nEvents=${1:-1000000}
+chunk=${2:-0}
+threads=${3:-$(nproc)}
+monitor=${MONITOR:-./Monitor}
+
+printf "%8s %10s %10s %10s\n" threads chunks "wall [s]" "tail [%]"
+for t in $threads; do
+  for mode in fixed adaptive; do
+    dir=$(mktemp -d)
+    cat > $dir/bench.mac <<EOM
+/control/execute analysis.mac
+/testhadr/output/crossings none
+/analysis/setFileName $dir/bench
+/run/initialize
+/run/beamOn $nEvents
+EOM
+    flag=""
+    if [ $mode = fixed ]; then flag=-fixedChunk; fi
+    start=$(date +%s.%N)
+    $monitor -t $t -chunk $chunk $flag $dir/bench.mac > $dir/log 2>&1
+    end=$(date +%s.%N)
+    tail=$(awk '/Load balance/ { print $(NF-4) }' $dir/log)
+    printf "%8d %10s %10.1f %10s\n" $t $mode $(echo "$end - $start" | bc) "$tail"
+    rm -rf $dir
+  done
+done
@@ -0,0 +1,40 @@
+#!/bin/sh
+#
+# End-of-run output latency for 1..N threads, with one ntuple file per
+# thread and with row-wise merged ntuples (/testhadr/output/mergeNtuples).
+#
+# Usage (from the build directory):
+#   ../bench/mergeScaling.sh [nEvents] [maxThreads]
+#
+# The latency reported is the slowest worker end-of-run write ("Thread i :
+# end-of-run output written in") plus the master one ("End-of-run output
+# written in"), as printed by RunAction.
+#
+nEvents=${1:-100000}
+maxThreads=${2:-64}
+monitor=${MONITOR:-./Monitor}
+
+printf "%8s %12s %14s %8s\n" threads mode "latency [s]" files
+t=1
+while [ $t -le $maxThreads ]; do
+  for merge in false true; do
+    dir=$(mktemp -d)
+    cat > $dir/bench.mac <<EOM
+/control/execute analysis.mac
+/testhadr/output/mergeNtuples $merge
+/analysis/setFileName $dir/bench
+/run/initialize
+/run/beamOn $nEvents
+EOM
+    G4FORCENUMBEROFTHREADS=$t $monitor $dir/bench.mac > $dir/log 2>&1
+    latency=$(awk '/end-of-run output written in/ {
+                     if ($(NF-1) > w) w = $(NF-1) }
+                   /End-of-run output written in/ { m = $(NF-1) }
+                   END { print w + m }' $dir/log)
+    files=$(ls $dir/*.root 2>/dev/null | wc -l)
+    if [ $merge = true ]; then mode=merged; else mode=per-thread; fi
+    printf "%8d %12s %14s %8d\n" $t $mode "$latency" $files
+    rm -rf $dir
+  done
+  t=$((t*2))
+done
@@ -0,0 +1,67 @@
+#!/bin/sh
+#
+# Event rate for 1 to all cores, threads left to the scheduler and pinned
+# compact or scatter (-pin of Monitor, merges per NUMA node).
+#
+# Usage (from the build directory):
+#   ../bench/threadScaling.sh [nEvents per thread] [maxThreads] [policies]
+#   ../bench/threadScaling.sh 20000 64 "none compact scatter"
+#
+# The number of events grows with the threads (weak scaling): speedup =
+# rate(t)/rate(1, none), efficiency = speedup/t. The rate is taken over
+# the event loop printed at end of run ("Event loop"), without the start
+# of the process (cross-section tables); "merge" is the time the merges
+# of the workers (per node if pinned) took after the last event. Only
+# the Run tallies go through that merge: the histograms and ntuples of
+# G4AnalysisManager are still merged flat, by each thread in its
+# end-of-run action, and are not in the "merge" column. The 1-thread
+# unpinned run, the base of the speedup, is made first whatever the
+# policies listed.
+#
+nEvents=${1:-20000}
+maxThreads=${2:-$(nproc)}
+policies=${3:-"none compact scatter"}
+monitor=${MONITOR:-./Monitor}
+
+# run <threads> <pinning>: sets rate and merge
+run() {
+  dir=$(mktemp -d)
+  n=$((nEvents*$1))
+  cat > $dir/bench.mac <<EOM
+/control/execute analysis.mac
+/testhadr/output/crossings none
+/analysis/setFileName $dir/bench
+/run/initialize
+/run/beamOn $n
+EOM
+  $monitor -t $1 -pin $2 $dir/bench.mac > $dir/log 2>&1
+  loop=$(awk '$1 == "Event" && $2 == "loop:" { print $3 }' $dir/log)
+  merge=$(awk '$1 == "Event" && $2 == "loop:" { print $6 }' $dir/log)
+  rate=$(echo "$n / $loop" | bc -l)
+  rm -rf $dir
+}
+
+printf "%8s %8s %12s %10s %8s %10s\n" \
+       threads pinning "events/s" speedup "eff [%]" "merge [s]"
+run 1 none
+base=$rate
+baseMerge=$merge
+t=1
+while [ $t -le $maxThreads ]; do
+  for pin in $policies; do
+    if [ $t -eq 1 ] && [ $pin = none ]; then
+      rate=$base
+      merge=$baseMerge
+    else
+      run $t $pin
+    fi
+    speedup=$(echo "$rate / $base" | bc -l)
+    printf "%8d %8s %12.1f %10.2f %8.1f %10s\n" $t $pin $rate $speedup \
+           $(echo "100 * $speedup / $t" | bc -l) "$merge"
+  done
+  if [ $t -lt $maxThreads ] && [ $((t*2)) -gt $maxThreads ]; then
+    t=$maxThreads
+  else
+    t=$((t*2))
+  fi
+done
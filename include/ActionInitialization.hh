@@ -31,6 +31,7 @@
 #define ActionInitialization_h 1
 
 #include "G4VUserActionInitialization.hh"
+#include "globals.hh"
 
 class DetectorConstruction;
 class G4VSteppingVerbose;
@@ -41,7 +42,8 @@ class G4VSteppingVerbose;
 class ActionInitialization : public G4VUserActionInitialization
 {
   public:
-    ActionInitialization(DetectorConstruction* detector);
+    // adjoint: also the actions of the reverse Monte Carlo mode
+    ActionInitialization(DetectorConstruction* detector, G4bool adjoint = false);
     virtual ~ActionInitialization();
 
     virtual void BuildForMaster() const;
@@ -51,6 +53,7 @@ class ActionInitialization : public G4VUserActionInitialization
    
   private:
     DetectorConstruction* fDetector;
+    G4bool                fAdjoint;
 };
 
 #endif
@@ -0,0 +1,68 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file AdjointPhysics.hh
+/// \brief Definition of the AdjointPhysics class
+//
+// Processes of the adjoint gammas of the reverse Monte Carlo mode
+// (Monitor -adjoint, G4AdjointSimManager). Geant4 has adjoint models for
+// the electromagnetic interactions only, so the mode covers the gamma
+// dose: an adjoint gamma started on the receptor gains energy by inverse
+// Compton scattering and is absorbed by the forward photoelectric effect
+// and pair production, down to the external source surface around the
+// tank or the DD source. Neutrons have no adjoint transport in Geant4
+// and stay forward-only.
+// The forward gamma processes of G4EmStandardPhysics are registered to
+// the adjoint cross-section manager, which corrects the weights for the
+// difference of the adjoint and forward total cross sections. The gamma
+// general process (Geant4 10.5 and later) would hide the photoelectric
+// effect and the conversion from the absorption: it is switched off, and
+// the run is aborted if either process is not found.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef AdjointPhysics_h
+#define AdjointPhysics_h 1
+
+#include "G4VPhysicsConstructor.hh"
+#include "globals.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class AdjointPhysics : public G4VPhysicsConstructor
+{
+  public:
+    AdjointPhysics();
+   ~AdjointPhysics();
+
+    virtual void ConstructParticle();
+    virtual void ConstructProcess();
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,91 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file AdjointRunAction.hh
+/// \brief Definition of the AdjointRunAction class
+//
+// Run action of the reverse Monte Carlo mode (Monitor -adjoint), handed
+// to G4AdjointSimManager, which calls it around /adjoint/start_run.
+// The adjoint gammas start on the receptor (/adjoint/DefineAdjSource...)
+// and are scored when they reach the external source surface
+// (/adjoint/DefineExtSource...): each one adds w h(E_receptor) to the bin
+// of its energy at the source, h being the gamma fluence-to-dose
+// coefficient (FluenceToDose, /testhadr/tally/gammaDoseTable).
+// Divided by the number of events, a bin is the dose response [pSv cm2]
+// of the receptor to source gammas of that energy, in the normalisation
+// of G4AdjointSimManager; folded with the gamma fluence spectrum on the
+// source surface, it gives the dose. The responses are printed and
+// written to <fileName>_adjoint.csv.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef AdjointRunAction_h
+#define AdjointRunAction_h 1
+
+#include "G4UserRunAction.hh"
+#include "G4Timer.hh"
+#include "globals.hh"
+#include <vector>
+
+class FluenceToDose;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class AdjointRunAction : public G4UserRunAction
+{
+  public:
+    AdjointRunAction(const FluenceToDose*);
+   ~AdjointRunAction();
+
+    virtual void BeginOfRunAction(const G4Run*);
+    virtual void   EndOfRunAction(const G4Run*);
+
+    // an adjoint gamma started at receptorEnergy reaches the source
+    void Score(G4double sourceEnergy, G4double receptorEnergy, G4double weight);
+    // accumulate the per-event response of each bin
+    void EndOfEvent();
+
+  private:
+    G4int    GetBin(G4double energy) const;
+    G4double GetLowEdge(G4int bin) const;
+    void     Write(const G4String& fileName, G4int nbEvents) const;
+
+    const FluenceToDose* fDose;
+    G4double fLogEmin, fLogEmax;
+    G4int    fNbBins;
+
+    // response of the source-energy bins in the event, sums over events
+    std::vector<G4double> fEventSum;
+    std::vector<G4double> fSum1;
+    std::vector<G4double> fSum2;
+    G4bool   fEventScored;
+    G4Timer  fTimer;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
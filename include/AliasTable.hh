@@ -0,0 +1,108 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file AliasTable.hh
+/// \brief Definition of the AliasTable class
+//
+// Walker's alias method for a discrete distribution of n bins: each of the
+// n columns holds the probability of keeping its own bin and the alias bin
+// taking the rest, so that a bin is sampled in constant time from two
+// random numbers, whatever n (Vose's construction, O(n)).
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef AliasTable_h
+#define AliasTable_h 1
+
+#include <cstddef>
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class AliasTable
+{
+  public:
+    AliasTable() {};
+   ~AliasTable() {};
+
+    // weights need not be normalized; false if they are all zero
+    bool Build(const std::vector<double>& weight)
+    {
+      size_t n = weight.size();
+      double sum = 0.;
+      for (size_t i=0; i<n; ++i) sum += weight[i];
+      fProbability.clear();
+      fKeep.clear();
+      fAlias.clear();
+      if (n == 0 || sum <= 0.) return false;
+
+      fProbability.resize(n);
+      fKeep.resize(n);
+      fAlias.resize(n);
+      std::vector<size_t> small, large;
+      for (size_t i=0; i<n; ++i) {
+        fProbability[i] = weight[i]/sum;
+        fKeep[i] = n*fProbability[i];
+        fAlias[i] = i;
+        if (fKeep[i] < 1.) small.push_back(i);
+        else               large.push_back(i);
+      }
+      while (!small.empty() && !large.empty()) {
+        size_t s = small.back(); small.pop_back();
+        size_t l = large.back();
+        fAlias[s] = l;
+        fKeep[l] -= 1. - fKeep[s];
+        if (fKeep[l] < 1.) { large.pop_back(); small.push_back(l); }
+      }
+      // leftovers are 1 up to rounding
+      for (size_t i=0; i<small.size(); ++i) fKeep[small[i]] = 1.;
+      for (size_t i=0; i<large.size(); ++i) fKeep[large[i]] = 1.;
+      return true;
+    }
+
+    // bin for two uniform random numbers in [0,1)
+    inline size_t Sample(double u1, double u2) const
+    {
+      size_t column = size_t(u1*fKeep.size());
+      if (column >= fKeep.size()) column = fKeep.size() - 1;
+      return (u2 < fKeep[column]) ? column : fAlias[column];
+    }
+
+    bool   IsEmpty() const                  { return fKeep.empty(); };
+    size_t GetSize() const                  { return fKeep.size(); };
+    double GetProbability(size_t bin) const { return fProbability[bin]; };
+    void   Clear()  { fProbability.clear(); fKeep.clear(); fAlias.clear(); };
+
+  private:
+    std::vector<double> fProbability;   //normalized pdf of the bins
+    std::vector<double> fKeep;
+    std::vector<size_t> fAlias;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,130 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file BoundedQueue.hh
+/// \brief Definition of the BoundedQueue class
+//
+// Bounded lock-free multi-producer/multi-consumer queue (D. Vyukov's
+// sequence-numbered ring). Push and Pop never block: they return false
+// when the queue is full or empty and the caller decides how to wait.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef BoundedQueue_h
+#define BoundedQueue_h 1
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+template <typename T>
+class BoundedQueue
+{
+  public:
+    // capacity is rounded up to a power of 2
+    explicit BoundedQueue(size_t capacity)
+      : fMask(0), fPad0(), fEnqueuePos(0), fPad1(), fDequeuePos(0)
+    {
+      size_t size = 2;
+      while (size < capacity) size *= 2;
+      fCells.reset(new Cell[size]);
+      fMask = size - 1;
+      for (size_t i=0; i<size; ++i) {
+        fCells[i].fSequence.store(i, std::memory_order_relaxed);
+      }
+    }
+
+    bool Push(const T& data)
+    {
+      size_t pos = fEnqueuePos.load(std::memory_order_relaxed);
+      for (;;) {
+        Cell& cell = fCells[pos & fMask];
+        size_t seq = cell.fSequence.load(std::memory_order_acquire);
+        std::ptrdiff_t dif = std::ptrdiff_t(seq) - std::ptrdiff_t(pos);
+        if (dif == 0) {
+          if (fEnqueuePos.compare_exchange_weak(pos, pos+1,
+                                                std::memory_order_relaxed)) {
+            cell.fData = data;
+            cell.fSequence.store(pos+1, std::memory_order_release);
+            return true;
+          }
+        }
+        else if (dif < 0) return false;                     //full
+        else pos = fEnqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+
+    bool Pop(T& data)
+    {
+      size_t pos = fDequeuePos.load(std::memory_order_relaxed);
+      for (;;) {
+        Cell& cell = fCells[pos & fMask];
+        size_t seq = cell.fSequence.load(std::memory_order_acquire);
+        std::ptrdiff_t dif = std::ptrdiff_t(seq) - std::ptrdiff_t(pos+1);
+        if (dif == 0) {
+          if (fDequeuePos.compare_exchange_weak(pos, pos+1,
+                                                std::memory_order_relaxed)) {
+            data = cell.fData;
+            cell.fSequence.store(pos+fMask+1, std::memory_order_release);
+            return true;
+          }
+        }
+        else if (dif < 0) return false;                     //empty
+        else pos = fDequeuePos.load(std::memory_order_relaxed);
+      }
+    }
+
+    // approximate number of queued elements
+    size_t GetSize() const
+    {
+      size_t in  = fEnqueuePos.load(std::memory_order_relaxed);
+      size_t out = fDequeuePos.load(std::memory_order_relaxed);
+      return (in > out) ? in - out : 0;
+    }
+
+    size_t GetCapacity() const { return fMask + 1; }
+
+  private:
+    struct Cell {
+      std::atomic<size_t> fSequence;
+      T                   fData;
+    };
+
+    // producers and consumers update the two positions: keep them on
+    // separate cache lines
+    std::unique_ptr<Cell[]> fCells;
+    size_t                  fMask;
+    char                    fPad0[64];
+    std::atomic<size_t>     fEnqueuePos;
+    char                    fPad1[64];
+    std::atomic<size_t>     fDequeuePos;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,105 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file CadisTool.hh
+/// \brief Definition of the CadisTool class
+//
+// Tool mode generating the weight windows and the angular source biasing
+// of a production run, CADIS-style, from a coarse deterministic estimate
+// of the adjoint (importance) function of a target tally: dose at one or
+// more points, e.g. a patch of a room wall or a test volume.
+// The adjoint flux at r is the point kernel
+//     phi+(r) = sum_t exp(-tau(r,t)) / (4 pi |r-t|^2)
+// tau being the fast-neutron removal optical thickness from r to target t,
+// ray-traced through the mass geometry with the removal cross sections of
+// the materials, evaluated at the centres of the WeightWindowWorld cells.
+// Source and windows are made consistent, as CADIS requires:
+//  - a direction of emission gets the importance phi+ of the cell entered
+//    on leaving the source cell, i.e. of the first window met;
+//  - R is the mean of these importances over the isotropic source, and
+//    the biased angular pdf is importance/R times the isotropic one;
+//  - the window of a cell is centred on R/phi+(cell) (wl = centre/survival
+//    factor, as the windows of a pilot run, WeightWindowWorld).
+// A primary is thus born with the centre of its first window as weight,
+// and is not split or rouletted at once. The source must be in the mesh.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef CadisTool_h
+#define CadisTool_h 1
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include <map>
+#include <vector>
+
+class DetectorConstruction;
+class CadisMessenger;
+class G4Material;
+class G4Navigator;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class CadisTool
+{
+  public:
+    CadisTool(DetectorConstruction*);
+   ~CadisTool();
+
+    void AddTarget(const G4ThreeVector& point)  { fTarget.push_back(point); };
+    void ClearTargets()                         { fTarget.clear(); };
+    void SetSource(const G4ThreeVector& point)  { fSource = point; };
+    void SetAngularBins(G4int nbCos, G4int nbPhi)
+                                      { fNbCos = nbCos; fNbPhi = nbPhi; };
+
+    // compute the importance map and write the weight windows of the
+    // WeightWindowWorld mesh and the angular source biasing (Idle state)
+    void Run(const G4String& windowFile, const G4String& sourceFile);
+
+    // removal macroscopic cross section [1/length] of a material
+    G4double GetRemovalCrossSection(const G4Material*);
+
+  private:
+    G4double OpticalThickness(const G4ThreeVector& from, const G4ThreeVector& to);
+    G4double Adjoint(const G4ThreeVector& point, G4double minDistance);
+    G4bool   WriteSourceBias(const G4String& fileName,
+                             const std::vector<G4double>& probability) const;
+
+    DetectorConstruction*  fDetector;
+    CadisMessenger*        fMessenger;
+    G4Navigator*           fNavigator;
+
+    std::vector<G4ThreeVector> fTarget;
+    G4ThreeVector          fSource;
+    G4int                  fNbCos, fNbPhi;
+
+    std::map<const G4Material*, G4double> fRemoval;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
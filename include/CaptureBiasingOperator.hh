@@ -0,0 +1,105 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file CaptureBiasingOperator.hh
+/// \brief Definition of the CaptureBiasingOperator class
+//
+// Occurrence biasing of the neutron capture (generic biasing): in the
+// volumes where NeutronHPphysics asks for it, the capture cross section
+// seen by the tracking is multiplied by a factor, and the weight corrected
+// by the ratio of the analog to the biased probabilities.
+// Factor > 1 (by material) makes the captures happen sooner: the weight at
+// capture is exp((factor-1) Sigma_c l)/factor, the survivors gaining
+// exp((factor-1) Sigma_c l). Capture ends the neutron, so where nearly
+// all neutrons are captured anyway (the tank) this gives no more capture
+// gammas, only earlier ones of spread weights, and may raise the variance.
+// Factor 0 is implicit capture: the neutron is never absorbed, its weight
+// is reduced along its flight by the probability to survive the capture,
+// exp(-Sigma_c l); below the weight cutoff it plays Russian roulette
+// (PlayRoulette, called from SteppingAction).
+// The operator is thread local, it is attached to the logical volumes at
+// each run since the geometry may have been rebuilt.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef CaptureBiasingOperator_h
+#define CaptureBiasingOperator_h 1
+
+#include "G4VBiasingOperator.hh"
+#include "globals.hh"
+#include <map>
+
+class NeutronHPphysics;
+class G4BOptnChangeCrossSection;
+class G4LogicalVolume;
+class G4Track;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class CaptureBiasingOperator : public G4VBiasingOperator
+{
+  public:
+    CaptureBiasingOperator(const NeutronHPphysics*);
+   ~CaptureBiasingOperator();
+
+    virtual void StartRun();
+
+    // implicit capture in the volume: weight cutoff and roulette apply
+    G4bool HasImplicitCapture(const G4LogicalVolume*) const;
+    void   PlayRoulette(G4Track*) const;
+
+  private:
+    virtual G4VBiasingOperation*
+    ProposeOccurenceBiasingOperation(const G4Track*,
+                                     const G4BiasingProcessInterface*);
+    virtual G4VBiasingOperation*
+    ProposeFinalStateBiasingOperation(const G4Track*,
+                                      const G4BiasingProcessInterface*)
+                                      { return 0; };
+    virtual G4VBiasingOperation*
+    ProposeNonPhysicsBiasingOperation(const G4Track*,
+                                      const G4BiasingProcessInterface*)
+                                      { return 0; };
+
+    using G4VBiasingOperator::OperationApplied;
+    virtual void OperationApplied(const G4BiasingProcessInterface*,
+                                  G4BiasingAppliedCase,
+                                  G4VBiasingOperation* occurenceOperationApplied,
+                                  G4double weightForOccurenceInteraction,
+                                  G4VBiasingOperation* finalStateOperationApplied,
+                                  const G4VParticleChange*);
+
+    const NeutronHPphysics*  fPhysics;
+    G4BOptnChangeCrossSection* fOperation;   //one wrapped process: nCapture
+
+    // capture factor of the attached volumes, refreshed at each run
+    std::map<const G4LogicalVolume*, G4double> fFactor;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
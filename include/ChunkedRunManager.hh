@@ -0,0 +1,125 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file ChunkedRunManager.hh
+/// \brief Definition of the ChunkedRunManager class
+//
+// G4MTRunManager handing the events to the workers by chunks that shrink
+// as the run nears its end (guided self-scheduling), at most the event
+// modulo (/run/eventModulo, or -chunk of Monitor) and at least minChunk.
+// The time each worker takes per event is measured between its requests
+// (moving average): a worker gets the events it should process in
+// 1/divisor of the time left to the run, the time left being the events
+// not handed out over the summed rates of the workers. Slow cores (E
+// cores, shared nodes) get fewer events than fast ones; the last events
+// go out one or a few at a time, so that no worker finishes the run
+// alone. Before its first measurement a worker gets remaining/(divisor x
+// nb of threads) events. The seeds follow the event IDs: the results do
+// not depend on the chunking.
+// The spread of the times the workers ran out of events is printed at
+// end of run, per thread with /run/verbose 1, with the time of the event
+// loop (first request to the last worker out of events) and of the merges
+// (MergePartialResults of the workers, NodeWorkerRunManager) after it.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef ChunkedRunManager_h
+#define ChunkedRunManager_h 1
+
+#include "G4Types.hh"
+
+#ifdef G4MULTITHREADED
+
+#include "G4MTRunManager.hh"
+
+#include <chrono>
+#include <mutex>
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class ChunkedRunManager : public G4MTRunManager
+{
+  public:
+    ChunkedRunManager();
+    virtual ~ChunkedRunManager();
+
+    virtual void RunInitialization();
+    virtual void RunTermination();
+
+    // called by the workers when they run out of events; both take the
+    // lock under which the chunks are handed out and the loads updated
+    virtual size_t SetUpNEvents(G4Event*, G4SeedsQueue*,
+                                G4bool reseedRequired = true);
+    virtual G4bool SetUpAnEvent(G4Event*, long& s1, long& s2, long& s3,
+                                G4bool reseedRequired = true);
+
+    // called by the workers around their MergePartialResults
+    void BeginMerge();
+    void EndMerge();
+
+    void SetMinChunk(G4int n)     { fMinChunk = (n > 0) ? n : 1; };
+    void SetChunkDivisor(G4int n) { fDivisor  = (n > 0) ? n : 1; };
+    // false: fixed chunks of the event modulo, as G4MTRunManager (the
+    // loads are still measured)
+    void SetAdaptive(G4bool adaptive) { fAdaptive = adaptive; };
+
+  private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct WorkerLoad {
+      WorkerLoad() : runID(-1), nbEvents(0), cost(0.), busy(0.),
+                     total(0), start(0.), done(0.), merge(0.),
+                     merged(0.) {};
+      G4int             runID;     //run of the last request
+      Clock::time_point last;      //time of the last request
+      G4int             nbEvents;  //handed out at the last request
+      G4double          cost;      //s per event, moving average; 0: unknown
+      G4double          busy;      //s spent on the chunks of this run
+      G4int             total;     //events of this run
+      G4double          start;     //s from begin of run to the first request
+      G4double          done;      //s from begin of run to the last request
+      G4double          merge;     //s spent in MergePartialResults
+      G4double          merged;    //s from begin of run to the end of it
+    };
+
+    WorkerLoad& EndChunk();
+    G4int GetChunkSize(const WorkerLoad&, G4int maxChunk) const;
+
+    std::mutex              fMutex;
+    G4bool                  fAdaptive;
+    G4int                   fMinChunk;
+    G4int                   fDivisor;
+    G4int                   fRunID;
+    Clock::time_point       fRunStart;
+    std::vector<WorkerLoad> fLoads;    //indexed by thread ID
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
+#endif
@@ -0,0 +1,68 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file CompactSchema.hh
+/// \brief Encoding of the crossing ntuples in the "compact" schema
+//
+// Positions are stored as fixed-point integers (1 mm quantum) and the
+// kinetic energy as a log-quantized integer code (0.23% relative step).
+// This header has no Geant4 dependency: it is also included by the ROOT
+// macros (NtupleValue.h) to decode the columns.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef CompactSchema_h
+#define CompactSchema_h 1
+
+#include <cmath>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace CompactSchema
+{
+  const double kPositionQuantum = 1.e-3;   // [m]
+  const double kEnergyDecades   = 1000.;   // codes per decade of energy
+  const double kEnergyMin       = 1.e-11;  // [MeV], smaller values clamped
+
+  // position in m <-> fixed-point code
+  inline int EncodePosition(double x)
+  { return int(std::floor(x/kPositionQuantum + 0.5)); }
+  inline double DecodePosition(int code)
+  { return code*kPositionQuantum; }
+
+  // kinetic energy in MeV <-> log-quantized code
+  inline int EncodeEnergy(double e)
+  {
+    if (e < kEnergyMin) e = kEnergyMin;
+    return int(std::floor(kEnergyDecades*std::log10(e) + 0.5));
+  }
+  inline double DecodeEnergy(int code)
+  { return std::pow(10., code/kEnergyDecades); }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
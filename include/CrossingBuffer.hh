@@ -0,0 +1,109 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file CrossingBuffer.hh
+/// \brief Definition of the CrossingRecord, CrossingSink and CrossingBuffer
+//
+// Boundary crossings are appended by the stepping action as packed POD
+// records to a per-thread buffer of fixed capacity. Whole blocks are
+// handed to a CrossingSink when the buffer is full and at end of run, so
+// that the ntuples are not touched from the stepping action.
+// G4AnalysisManager has no block fill: the sink still fills each row
+// column by column, but with one manager lookup per block. The buffer is
+// a plain array flushed when full, not a ring: producer and sink are the
+// same worker thread (the queue to another thread is CrossingWriter's).
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef CrossingBuffer_h
+#define CrossingBuffer_h 1
+
+#include "globals.hh"
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+struct CrossingRecord
+{
+  enum { kNeutron = 0, kGamma = 1 };  // == ntuple ID of nFlux / gFlux
+
+  G4double x, y, z;     // position [m], as written in the ntuples
+  G4double energy;      // kinetic energy (G4 internal units)
+  G4double weight;      // statistical weight of the track
+  G4int    eventID;
+  G4int    particle;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class CrossingSink
+{
+  public:
+    virtual ~CrossingSink() {};
+    virtual void WriteCrossings(const CrossingRecord*, size_t n) = 0;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class CrossingBuffer
+{
+  public:
+    CrossingBuffer(CrossingSink*, size_t capacity = 4096);
+   ~CrossingBuffer();
+
+    void SetEventID(G4int id) { fEventID = id; };
+
+    inline void Push(G4int particle, G4double x, G4double y, G4double z,
+                     G4double energy, G4double weight);
+
+    // hand all buffered records to the sink
+    void Flush();
+
+  private:
+    CrossingSink*               fSink;
+    std::vector<CrossingRecord> fRecords;   // allocated once, reused
+    size_t                      fSize;
+    G4int                       fEventID;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void CrossingBuffer::Push(G4int particle,
+                                 G4double x, G4double y, G4double z,
+                                 G4double energy, G4double weight)
+{
+  CrossingRecord& rec = fRecords[fSize];
+  rec.x = x; rec.y = y; rec.z = z;
+  rec.energy   = energy;
+  rec.weight   = weight;
+  rec.eventID  = fEventID;
+  rec.particle = particle;
+  if (++fSize == fRecords.size()) Flush();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
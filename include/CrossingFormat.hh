@@ -0,0 +1,106 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file CrossingFormat.hh
+/// \brief Layout of the binary columnar crossing file
+//
+// A crossing file is a FileHeader followed by chunks. Each chunk is a
+// ChunkHeader followed by the columns of its rows, one after the other,
+// each padded to 8 bytes:
+//   x, y, z [m], E [MeV], w   : float32
+//   event                     : int32
+//   particle                  : uint8 (CrossingRecord::kNeutron/kGamma)
+// All widths are fixed, so a reader can mmap the file and access every
+// column of a chunk as a plain array. No Geant4 dependency: this header
+// is shared by the writer (CrossingWriter) and the reader (tools/).
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef CrossingFormat_h
+#define CrossingFormat_h 1
+
+#include <cstddef>
+#include <cstdint>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace CrossingFormat
+{
+  const char     kMagic[8]    = { 'M','O','N','X','C','O','L','1' };
+  const uint32_t kVersion     = 1;
+  const uint32_t kChunkMagic  = 0x4b4e4843;   // "CHNK"
+
+  enum ColumnType { kFloat32 = 1, kInt32 = 2, kUInt8 = 3 };
+  enum ColumnId   { kX, kY, kZ, kEnergy, kWeight, kEvent, kParticle,
+                    kNbColumns };
+
+  struct Column {
+    char     name[16];
+    uint32_t type;
+    uint32_t width;      // bytes per row
+  };
+
+  const Column kColumns[kNbColumns] = {
+    { "x",        kFloat32, 4 },
+    { "y",        kFloat32, 4 },
+    { "z",        kFloat32, 4 },
+    { "E",        kFloat32, 4 },
+    { "w",        kFloat32, 4 },
+    { "event",    kInt32,   4 },
+    { "particle", kUInt8,   1 }
+  };
+
+  struct FileHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t nbColumns;
+    Column   columns[kNbColumns];
+  };
+
+  struct ChunkHeader {
+    uint32_t magic;
+    uint32_t nbRows;
+    uint64_t nbBytes;    // size of the chunk, header included
+  };
+
+  // size of one column of n rows, padded to 8 bytes
+  inline size_t ColumnBytes(ColumnId id, size_t n)
+  { return (kColumns[id].width*n + 7) & ~size_t(7); }
+
+  // offset of a column from the start of its chunk
+  inline size_t ColumnOffset(ColumnId id, size_t n)
+  {
+    size_t offset = sizeof(ChunkHeader);
+    for (int k=0; k<id; ++k) offset += ColumnBytes(ColumnId(k), n);
+    return offset;
+  }
+
+  inline size_t ChunkBytes(size_t n) { return ColumnOffset(kNbColumns, n); }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
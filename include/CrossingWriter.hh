@@ -0,0 +1,107 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file CrossingWriter.hh
+/// \brief Definition of the CrossingWriter class
+//
+// Asynchronous output of the boundary-crossing records. Worker threads
+// copy their filled CrossingBuffer blocks into pooled blocks and hand them
+// over a bounded lock-free queue to one dedicated writer thread, which
+// transposes each block into a column chunk (CrossingFormat.hh), so that
+// this work and the file writes overlap with transport. Producers only wait (stall) when
+// all pooled blocks are queued; queue depth and stall time are reported
+// when the writer is closed at end of run.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef CrossingWriter_h
+#define CrossingWriter_h 1
+
+#include "globals.hh"
+#include "CrossingBuffer.hh"
+#include "BoundedQueue.hh"
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class CrossingWriter : public CrossingSink
+{
+  public:
+    static CrossingWriter* Instance();
+
+    // start the writer thread on fileName (master, begin of run)
+    void Open(const G4String& fileName, size_t nbBlocks = 64,
+              size_t blockSize = 4096);
+    // drain the queue, stop the writer thread and print the metrics
+    // (master, end of run, once all workers have flushed)
+    void Close();
+
+    G4bool IsOpen() const { return fFile != 0; };
+
+    // thread safe: called by the worker threads
+    virtual void WriteCrossings(const CrossingRecord*, size_t n);
+
+  private:
+    CrossingWriter();
+   ~CrossingWriter();
+
+    struct Block {
+      std::vector<CrossingRecord> fRecords;
+      size_t                      fSize;
+    };
+
+    void WriterLoop();
+    void WriteBlock(const Block*);
+    void UpdateMaxDepth();
+
+  private:
+    BoundedQueue<Block*>* fFullBlocks;     // workers -> writer
+    BoundedQueue<Block*>* fFreeBlocks;     // writer  -> workers
+    std::vector<Block*>   fBlocks;
+    size_t                fBlockSize;
+
+    std::thread           fThread;
+    std::atomic<bool>     fStop;
+    std::FILE*            fFile;
+    G4String              fFileName;
+    std::vector<char>     fChunk;          // writer thread scratch buffer
+
+    // backpressure metrics
+    std::atomic<size_t>    fMaxDepth;
+    std::atomic<long>      fNbStalls;
+    std::atomic<long long> fStallTime;     // [ns]
+    size_t                 fNbBlocksWritten;
+    size_t                 fNbRecords;
+    G4double               fWriteTime;     // [s], writer thread busy
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
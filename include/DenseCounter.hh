@@ -0,0 +1,144 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file DenseCounter.hh
+/// \brief Definition of the NameRegistry and PointerIndex classes
+//
+// Support for the dense process/particle counters of Run.
+// A NameRegistry gives every process (or particle) name a small integer ID
+// shared by all threads; a PointerIndex is a per-thread open-addressing
+// table caching the ID of each object pointer, so that the per-step lookup
+// is a hash of the pointer and one or two compares.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef DenseCounter_h
+#define DenseCounter_h 1
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class NameRegistry
+{
+  public:
+    NameRegistry() {};
+   ~NameRegistry() {};
+
+    // ID of name, registered on first call (thread safe)
+    int Register(const std::string& name)
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      for (size_t i=0; i<fNames.size(); ++i) {
+        if (fNames[i] == name) return int(i);
+      }
+      fNames.push_back(name);
+      return int(fNames.size()) - 1;
+    }
+
+    std::string GetName(int id) const
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      return fNames[id];
+    }
+
+    int GetSize() const
+    {
+      std::lock_guard<std::mutex> lock(fMutex);
+      return int(fNames.size());
+    }
+
+  private:
+    mutable std::mutex       fMutex;
+    std::vector<std::string> fNames;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class PointerIndex
+{
+  public:
+    PointerIndex() : fKeys(kInitialSize, nullptr), fIds(kInitialSize, -1),
+                     fMask(kInitialSize-1), fSize(0) {};
+   ~PointerIndex() {};
+
+    // ID cached for key, -1 if the key has not been inserted yet
+    inline int Find(const void* key) const
+    {
+      size_t slot = Hash(key) & fMask;
+      while (fKeys[slot]) {
+        if (fKeys[slot] == key) return fIds[slot];
+        slot = (slot + 1) & fMask;
+      }
+      return -1;
+    }
+
+    void Insert(const void* key, int id)
+    {
+      if (2*(fSize+1) > fKeys.size()) Grow();
+      size_t slot = Hash(key) & fMask;
+      while (fKeys[slot] && fKeys[slot] != key) slot = (slot + 1) & fMask;
+      if (!fKeys[slot]) ++fSize;
+      fKeys[slot] = key;
+      fIds[slot]  = id;
+    }
+
+  private:
+    static const size_t kInitialSize = 64;
+
+    static inline size_t Hash(const void* key)
+    {
+      uint64_t h = reinterpret_cast<uintptr_t>(key);
+      h ^= h >> 17;
+      h *= 0x9E3779B97F4A7C15ULL;
+      return size_t(h >> 32);
+    }
+
+    void Grow()
+    {
+      std::vector<const void*> keys; keys.swap(fKeys);
+      std::vector<int>         ids;  ids.swap(fIds);
+      fKeys.assign(2*keys.size(), nullptr);
+      fIds.assign(2*keys.size(), -1);
+      fMask = fKeys.size() - 1;
+      fSize = 0;
+      for (size_t i=0; i<keys.size(); ++i) {
+        if (keys[i]) Insert(keys[i], ids[i]);
+      }
+    }
+
+    std::vector<const void*> fKeys;
+    std::vector<int>         fIds;
+    size_t                   fMask;
+    size_t                   fSize;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
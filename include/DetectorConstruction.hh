@@ -36,10 +36,16 @@
 
 #include "G4VUserDetectorConstruction.hh"
 #include "globals.hh"
+#include "G4ThreeVector.hh"
+#include "G4VPhysicalVolume.hh"
 
 class G4LogicalVolume;
 class G4Material;
 class DetectorMessenger;
+class ScoringWorld;
+class ImportanceWorld;
+class WeightWindowWorld;
+class CadisTool;
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -53,6 +59,7 @@ public:
   virtual G4VPhysicalVolume* Construct();
   void SetSize     (G4double, G4double, G4double);              
   void SetMaterial (G4String);
+  void SetWallThickness(G4double);
     
 
   G4Material* 
@@ -63,6 +70,24 @@ public:
                           
   G4Material*        GetMaterial()   {return fMaterial;};
   G4double           GetSize()       {return fBoxX;};
+  G4ThreeVector      GetRoomSize() const
+                       {return G4ThreeVector(fRoom_x,fRoom_y,fRoom_z);};
+  G4ThreeVector      GetRoomCenter() const
+                       {return roomP->GetTranslation();};
+  G4ThreeVector      GetTankSize() const
+                       {return G4ThreeVector(fTank_x,fTank_y,fTank_z);};
+  G4ThreeVector      GetTankCenter() const
+                       {return GetRoomCenter() + tankP->GetTranslation();};
+  const
+  G4LogicalVolume*   GetTankVolume() const {return tankL;};
+  G4ThreeVector      GetChamberSize() const
+                       {return G4ThreeVector(fChamber_x,fChamber_y,fChamber_z);};
+  G4ThreeVector      GetChamberCenter() const
+                       {return GetTankCenter() + chamberP->GetTranslation();};
+  ScoringWorld*      GetScoringWorld() {return fScoringWorld;};
+  ImportanceWorld*   GetImportanceWorld() {return fImportanceWorld;};
+  WeightWindowWorld* GetWeightWindowWorld() {return fWeightWindowWorld;};
+  CadisTool*         GetCadisTool()  {return fCadisTool;};
   void               PrintParameters();
 
   //world
@@ -93,6 +118,10 @@ private:
   G4double fInc;
   G4Material* fMaterial;
   DetectorMessenger* fDetectorMessenger;
+  ScoringWorld*      fScoringWorld;       //parallel world of the mesh tally
+  ImportanceWorld*   fImportanceWorld;    //parallel world of the biasing
+  WeightWindowWorld* fWeightWindowWorld;  //parallel world of the windows
+  CadisTool*         fCadisTool;          //windows from the adjoint
 
 
   //tank
@@ -64,6 +64,8 @@ private:
   G4UIcmdWithAString*        fMaterCmd;
   G4UIcmdWithADoubleAndUnit* fSizeCmd;
   G4UIcommand*               fIsotopeCmd;
+  G4UIcommand*               fMeshCmd;
+  G4UIcmdWithADoubleAndUnit* fWallCmd;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,94 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file ExpTransformOperator.hh
+/// \brief Definition of the ExpTransformOperator class
+//
+// Exponential transform (generic biasing): in the chosen volumes, every
+// cross section of the neutrons and gammas is scaled by (1 - p mu), mu the
+// cosine between the direction of flight and the radial direction from
+// the source centre, p the stretching parameter of the particle (0 <= p < 1).
+// Flights outward are stretched, flights back toward the source shortened;
+// G4BOptnChangeCrossSection corrects the weight at each step and interaction.
+// The operator is thread local, attached at each run like the
+// CaptureBiasingOperator; a volume takes only one of them.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef ExpTransformOperator_h
+#define ExpTransformOperator_h 1
+
+#include "G4VBiasingOperator.hh"
+#include "globals.hh"
+#include <map>
+
+class ExpTransformPhysics;
+class G4BOptnChangeCrossSection;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class ExpTransformOperator : public G4VBiasingOperator
+{
+  public:
+    ExpTransformOperator(const ExpTransformPhysics*);
+   ~ExpTransformOperator();
+
+    virtual void StartRun();
+
+  private:
+    virtual G4VBiasingOperation*
+    ProposeOccurenceBiasingOperation(const G4Track*,
+                                     const G4BiasingProcessInterface*);
+    virtual G4VBiasingOperation*
+    ProposeFinalStateBiasingOperation(const G4Track*,
+                                      const G4BiasingProcessInterface*)
+                                      { return 0; };
+    virtual G4VBiasingOperation*
+    ProposeNonPhysicsBiasingOperation(const G4Track*,
+                                      const G4BiasingProcessInterface*)
+                                      { return 0; };
+
+    using G4VBiasingOperator::OperationApplied;
+    virtual void OperationApplied(const G4BiasingProcessInterface*,
+                                  G4BiasingAppliedCase,
+                                  G4VBiasingOperation* occurenceOperationApplied,
+                                  G4double weightForOccurenceInteraction,
+                                  G4VBiasingOperation* finalStateOperationApplied,
+                                  const G4VParticleChange*);
+
+    void AddOperations(const G4ParticleDefinition*);
+
+    const ExpTransformPhysics*  fPhysics;
+
+    // one operation per wrapped process
+    std::map<const G4BiasingProcessInterface*, G4BOptnChangeCrossSection*>
+                                fOperation;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
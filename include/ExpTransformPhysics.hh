@@ -0,0 +1,88 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file ExpTransformPhysics.hh
+/// \brief Definition of the ExpTransformPhysics class
+//
+// Exponential transform of the neutron and gamma flights in the shield
+// (default: the Tank volume), see ExpTransformOperator. The stretching
+// parameters are only known once the macro has been read: the hadronic
+// and electromagnetic processes of the particles are wrapped for generic
+// biasing at ConstructProcess(), and only when a parameter is not zero.
+// Registered after the other constructors, so that it sees their processes.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef ExpTransformPhysics_h
+#define ExpTransformPhysics_h 1
+
+#include "G4VPhysicsConstructor.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+#include <vector>
+
+class ExpTransformMessenger;
+class G4LogicalVolume;
+class G4ParticleDefinition;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class ExpTransformPhysics : public G4VPhysicsConstructor
+{
+  public:
+    ExpTransformPhysics();
+   ~ExpTransformPhysics();
+
+    virtual void ConstructParticle() { };
+    virtual void ConstructProcess();
+
+    // stretching parameter p of the neutrons and gammas, 0: analog
+    void SetStretch(const G4String& particle, G4double p);
+    G4double GetStretch(const G4ParticleDefinition*) const;
+
+    // volumes of the transform, by logical volume name
+    void AddVolume(const G4String& name)   { fVolume.push_back(name); };
+    void ClearVolumes()                    { fVolume.clear(); };
+    G4bool IsTransformed(const G4LogicalVolume*) const;
+
+    // the preferred direction is radial from this point (the source)
+    void SetCenter(const G4ThreeVector& center) { fCenter = center; };
+    const G4ThreeVector& GetCenter() const      { return fCenter; };
+
+  private:
+    void WrapProcesses(const G4ParticleDefinition*);
+
+    ExpTransformMessenger*  fMessenger;
+    G4double                fNeutronStretch;
+    G4double                fGammaStretch;
+    std::vector<G4String>   fVolume;
+    G4ThreeVector           fCenter;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,114 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file FluenceToDose.hh
+/// \brief Definition of the FluenceToDose class
+//
+// Fluence-to-dose conversion coefficients h(E) [pSv cm2] of neutrons and
+// gammas. The ICRP-74 ambient dose equivalent H*(10) tables are built in;
+// other tables (e.g. ICRP-116 effective dose) are read from text files.
+// A table is resampled once, with log-log interpolation, on a uniform
+// grid in log(E); a lookup is then one log, one truncation and one
+// multiply-add, without search and without branches, and whole arrays
+// of energies can be converted in one call.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef FluenceToDose_h
+#define FluenceToDose_h 1
+
+#include "globals.hh"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class FluenceToDose
+{
+  public:
+    enum { kNbParticles = 2 };    // CrossingRecord::kNeutron, kGamma
+
+    FluenceToDose();              // ICRP-74 H*(10) for both particles
+   ~FluenceToDose();
+
+    void   UseICRP74(G4int particle);
+    // two columns: E [MeV], h [pSv cm2], increasing E; '#' starts a comment
+    G4bool LoadTable(G4int particle, const G4String& fileName);
+    void   SetConstant(G4int particle, G4double coefficient);
+
+    const G4String& GetTableName(G4int particle) const
+                                   { return fGrid[particle].name; };
+
+    // h(E) in pSv cm2; constant outside the energy range of the table
+    inline G4double GetCoefficient(G4int particle, G4double energy) const;
+    // h(E) of n energies at once
+    void Convert(G4int particle, const G4double* energy,
+                 G4double* coefficient, size_t n) const;
+
+    // the built-in table; E in MeV, h in pSv cm2
+    static void GetICRP74(G4int particle, std::vector<G4double>& energy,
+                          std::vector<G4double>& coefficient);
+    // log-log interpolation in the table itself (reference, slow)
+    static G4double Interpolate(const std::vector<G4double>& energy,
+                                const std::vector<G4double>& coefficient,
+                                G4double e);
+
+  private:
+    struct Cell { G4double intercept, slope; };   // h = intercept + slope*u
+
+    struct Grid {
+      G4double          logEmin;
+      G4double          invStep;   // cells per unit of log(E)
+      G4double          uMax;      // nb of cells
+      G4int             lastCell;
+      std::vector<Cell> cells;
+      G4String          name;
+    };
+
+    void BuildGrid(G4int particle, const std::vector<G4double>& energy,
+                   const std::vector<G4double>& coefficient,
+                   const G4String& name);
+
+    Grid fGrid[kNbParticles];
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline G4double FluenceToDose::GetCoefficient(G4int particle,
+                                              G4double energy) const
+{
+  // u: position on the grid, in cells; clamped to the table range
+  const Grid& grid = fGrid[particle];
+  G4double u = (std::log(energy) - grid.logEmin)*grid.invStep;
+  u = std::min(std::max(u, 0.), grid.uMax);
+  const Cell& cell = grid.cells[std::min(G4int(u), grid.lastCell)];
+  return cell.intercept + cell.slope*u;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
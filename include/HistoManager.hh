@@ -34,21 +34,119 @@
 #define HistoManager_h 1
 
 #include "globals.hh"
+#include "CrossingBuffer.hh"
+#include "SurfaceTally.hh"
+#include "FluenceToDose.hh"
+#include "MeshTally.hh"
+#include "SparseMeshTally.hh"
+#include "PointDetectorTally.hh"
 
 #include "g4root.hh"
 //#include "g4xml.hh"
 
+class HistoMessenger;
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-class HistoManager
+class HistoManager : public CrossingSink
 {
   public:
    HistoManager();
   ~HistoManager();
 
+   // fill the nFlux/gFlux ntuples from a block of crossing records
+   virtual void WriteCrossings(const CrossingRecord*, size_t n);
+
+   // destination of the crossing records: "ntuple", "binary", "both"
+   // or "none"
+   void SetCrossingOutput(const G4String&);
+   G4bool WritesCrossings() const { return fNtupleCrossings || fBinaryCrossings; };
+   G4bool WritesBinaryCrossings() const { return fBinaryCrossings; };
+
+   // surface source: every particle leaving the tank is written to this
+   // phase-space file (PhaseSpaceWriter); "none" or empty: off
+   void SetPhaseSpaceFile(const G4String& fileName)
+                  { fPhaseSpaceFile = (fileName == "none") ? G4String() : fileName; };
+   G4bool WritesPhaseSpace() const      { return !fPhaseSpaceFile.empty(); };
+   const G4String& GetPhaseSpaceFile() const { return fPhaseSpaceFile; };
+
+   // neutron phase of a two-phase run: the secondary gammas (capture,
+   // inelastic or other) are written to this source file instead of
+   // being transported; "none" or empty: off
+   void SetGammaSourceFile(const G4String& fileName)
+                  { fGammaSourceFile = (fileName == "none") ? G4String() : fileName; };
+   G4bool WritesGammaSource() const     { return !fGammaSourceFile.empty(); };
+   const G4String& GetGammaSourceFile() const { return fGammaSourceFile; };
+
+   // column types of nFlux/gFlux: "double", "float" or "compact"
+   void SetNtupleSchema(const G4String&);
+   // book the ntuples once, with the selected schema (begin of run)
+   void BookNtuples();
+
+   // MT: workers stream their ntuple baskets row-wise into the master file
+   void SetNtupleMerging(G4bool merge) { fMergeNtuples = merge; };
+
+   // dose-rate maps of the lab walls (SurfaceTally), one H2 per face and
+   // particle
+   void SetSurfaceTally(G4bool active)  { fSurfaceTally = active; };
+   void SetTallyBinSize(G4double);
+   void SetSourceRate(G4double rate)    { fSourceRate = rate; };
+   // fluence-to-dose conversion: ICRP-74 by default
+   FluenceToDose* GetDoseConversion()   { return &fDoseConversion; };
+   G4bool HasSurfaceTally() const       { return fSurfaceTally; };
+   void ConfigureSurfaceTally(SurfaceTally*) const;
+   void ConfigureMeshTally(MeshTally*) const;
+
+   // sparse track-length mesh of the room; voxel size 0: off
+   void SetSparseVoxelSize(G4double size) { fSparseVoxelSize = size; };
+   G4bool HasSparseMesh() const         { return fSparseVoxelSize > 0.; };
+   void ConfigureSparseMesh(SparseMeshTally*) const;
+   G4double GetSparseVoxelSize() const  { return fSparseVoxelSize; };
+
+   // point detectors scored by the next-event estimator (PointEstimator);
+   // R clamped to the minimum distance, rays cached on cells (0: off)
+   void AddPointDetector(const G4ThreeVector& point) { fPoints.push_back(point); };
+   void ClearPointDetectors()           { fPoints.clear(); };
+   void SetPointMinDistance(G4double d) { fPointMinDistance = d; };
+   void SetPointCacheCell(G4double size) { fPointCacheCell = size; };
+   G4bool HasPointDetectors() const     { return !fPoints.empty(); };
+   const std::vector<G4ThreeVector>& GetPointDetectors() const { return fPoints; };
+   G4double GetPointMinDistance() const { return fPointMinDistance; };
+   G4double GetPointCacheCell() const   { return fPointCacheCell; };
+   void ConfigurePointTally(PointDetectorTally*) const;
+
+   // book the H2s once, with the binning of the first run
+   void BookSurfaceMaps(const SurfaceTally&);
+   // master, end of run: dose rates of the merged tally into the H2s
+   void FillSurfaceMaps(const SurfaceTally&, G4int nbEvents);
+
   private:
+    enum Schema { kDouble, kFloat, kCompact };
+
     void Book();
     G4String fFileName;
+
+    Schema          fSchema;
+    G4bool          fNtuplesBooked;
+    G4bool          fMergeNtuples;
+
+    G4bool          fSurfaceTally;
+    G4double        fTallyBinSize;
+    G4double        fSourceRate;
+    FluenceToDose   fDoseConversion;
+    G4double        fSparseVoxelSize;
+    std::vector<G4ThreeVector> fPoints;
+    G4double        fPointMinDistance;
+    G4double        fPointCacheCell;
+    G4bool          fSurfaceMapsBooked;
+    G4int           fSurfaceMapID[SurfaceTally::kNbParticles]
+                                 [SurfaceTally::kNbFaces];
+
+    G4bool          fNtupleCrossings;
+    G4bool          fBinaryCrossings;
+    G4String        fPhaseSpaceFile;
+    G4String        fGammaSourceFile;
+    HistoMessenger* fHistoMessenger;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
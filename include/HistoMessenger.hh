@@ -0,0 +1,85 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file HistoMessenger.hh
+/// \brief Definition of the HistoMessenger class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef HistoMessenger_h
+#define HistoMessenger_h 1
+
+#include "G4UImessenger.hh"
+#include "globals.hh"
+
+class HistoManager;
+class G4UIdirectory;
+class G4UIcmdWithAString;
+class G4UIcmdWithABool;
+class G4UIcmdWithADouble;
+class G4UIcmdWithADoubleAndUnit;
+class G4UIcmdWith3VectorAndUnit;
+class G4UIcmdWithoutParameter;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class HistoMessenger: public G4UImessenger
+{
+  public:
+    HistoMessenger(HistoManager*);
+   ~HistoMessenger();
+    
+    virtual void SetNewValue(G4UIcommand*, G4String);
+    
+  private:
+    HistoManager*        fHistoManager;
+    
+    G4UIdirectory*       fOutputDir;
+    G4UIcmdWithAString*  fCrossingsCmd;
+    G4UIcmdWithAString*  fSchemaCmd;
+    G4UIcmdWithABool*    fMergeCmd;
+    G4UIcmdWithAString*  fPhaseSpaceCmd;
+    G4UIcmdWithAString*  fGammaSourceCmd;
+
+    G4UIdirectory*             fTallyDir;
+    G4UIcmdWithABool*          fSurfaceCmd;
+    G4UIcmdWithADoubleAndUnit* fBinSizeCmd;
+    G4UIcmdWithADouble*        fSourceRateCmd;
+    G4UIcmdWithADouble*        fNeutronFactorCmd;
+    G4UIcmdWithADouble*        fGammaFactorCmd;
+    G4UIcmdWithAString*        fNeutronTableCmd;
+    G4UIcmdWithAString*        fGammaTableCmd;
+    G4UIcmdWithADoubleAndUnit* fSparseVoxelCmd;
+    G4UIcmdWith3VectorAndUnit* fPointCmd;
+    G4UIcmdWithoutParameter*   fClearPointsCmd;
+    G4UIcmdWithADoubleAndUnit* fPointDistanceCmd;
+    G4UIcmdWithADoubleAndUnit* fPointCacheCmd;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
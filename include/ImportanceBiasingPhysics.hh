@@ -0,0 +1,72 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file ImportanceBiasingPhysics.hh
+/// \brief Definition of the ImportanceBiasingPhysics class
+//
+// Splitting and Russian roulette of neutrons and gammas at the cell
+// boundaries of the ImportanceWorld. The number of layers is only known
+// once the macro has been read, so the parallel-world navigation and the
+// G4ImportanceBiasing processes are added at ConstructProcess(), and only
+// when the biasing is switched on.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef ImportanceBiasingPhysics_h
+#define ImportanceBiasingPhysics_h 1
+
+#include "G4VPhysicsConstructor.hh"
+#include "globals.hh"
+
+class ImportanceWorld;
+class G4GeometrySampler;
+class G4ImportanceBiasing;
+class G4ParallelWorldPhysics;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class ImportanceBiasingPhysics : public G4VPhysicsConstructor
+{
+  public:
+    ImportanceBiasingPhysics(ImportanceWorld*);
+   ~ImportanceBiasingPhysics();
+
+    virtual void ConstructParticle() { };
+    virtual void ConstructProcess();
+
+  private:
+    enum { kNbParticles = 2 };          // neutron, gamma
+
+    ImportanceWorld*         fWorld;
+    G4ParallelWorldPhysics*  fParallelWorld;
+    G4GeometrySampler*       fSampler[kNbParticles];
+    G4ImportanceBiasing*     fBiasing[kNbParticles];
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,91 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file ImportanceWorld.hh
+/// \brief Definition of the ImportanceWorld class
+//
+// Parallel world of the geometry-cell importance biasing: nested boxes
+// going from the chamber (core) to the outer faces of the water tank,
+// each shell being one layer of the tank walls. A particle crossing
+// outward into a cell of higher importance is split, inward it plays
+// Russian roulette (G4ImportanceBiasing, see ImportanceBiasingPhysics).
+// Cells: 0 = chamber, 1..N = layers of the walls, N+1 = outside the tank.
+// Default importance of cell k is ratio^k (ratio^N outside the tank).
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef ImportanceWorld_h
+#define ImportanceWorld_h 1
+
+#include "G4VUserParallelWorld.hh"
+#include "globals.hh"
+#include <vector>
+
+class DetectorConstruction;
+class ImportanceMessenger;
+class G4VPhysicalVolume;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class ImportanceWorld : public G4VUserParallelWorld
+{
+  public:
+    ImportanceWorld(const G4String& worldName, DetectorConstruction*);
+   ~ImportanceWorld();
+
+    virtual void Construct();
+
+    // nb of layers across the tank walls; 0: no biasing (default)
+    void SetNbLayers(G4int n);
+    void SetRatio(G4double ratio);
+    void SetImportance(G4int cell, G4double importance);
+
+    G4bool   HasLayers() const          { return fNbLayers > 0; };
+    G4int    GetNbLayers() const        { return fNbLayers; };
+    G4int    GetNbCells() const         { return fNbLayers + 2; };
+    G4double GetImportance(G4int cell) const { return fImportance[cell]; };
+
+    // copy the importances into the G4IStore of the calling thread
+    // (begin of run, so that changes made in Idle state are applied)
+    void UpdateImportanceStore();
+
+    void Print() const;
+
+  private:
+    void ResetImportances();
+
+    DetectorConstruction*  fDetector;
+    ImportanceMessenger*   fMessenger;
+    G4int                  fNbLayers;
+    G4double               fRatio;
+    std::vector<G4double>  fImportance;   // [cell]
+    std::vector<const G4VPhysicalVolume*> fCell;   // [cell], world last
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,66 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file MeshSD.hh
+/// \brief Definition of the MeshSD class
+//
+// Sensitive detector of the voxels of ScoringWorld: adds the weighted
+// track length of each neutron and gamma step to the MeshTally of the
+// current Run, given by RunAction at begin of run. No hits are created.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef MeshSD_h
+#define MeshSD_h 1
+
+#include "G4VSensitiveDetector.hh"
+#include "globals.hh"
+
+class MeshTally;
+class G4ParticleDefinition;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class MeshSD : public G4VSensitiveDetector
+{
+  public:
+    MeshSD(const G4String& name);
+   ~MeshSD();
+
+    // tally of the run starting (thread local)
+    void BeginOfRun(MeshTally* tally) { fTally = tally; };
+
+    virtual G4bool ProcessHits(G4Step*, G4TouchableHistory*);
+
+  private:
+    MeshTally*                  fTally;
+    const G4ParticleDefinition* fNeutron;
+    const G4ParticleDefinition* fGamma;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
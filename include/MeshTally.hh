@@ -0,0 +1,103 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file MeshTally.hh
+/// \brief Definition of the MeshTally class
+//
+// Track-length fluence and dose of neutrons and gammas on a regular voxel
+// mesh over the Room volume (ScoringWorld, MeshSD). Each step adds w*L
+// and w*L*h(E) to the sums of its voxel; sum/volume is the fluence, and
+// the dose, per source particle. The sums are contiguous per-thread
+// arrays, added up in Run::Merge and written by the master at end of run.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef MeshTally_h
+#define MeshTally_h 1
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include "FluenceToDose.hh"
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class MeshTally
+{
+  public:
+    enum { kNbParticles = 2 };    // CrossingRecord::kNeutron, kGamma
+
+    MeshTally();
+   ~MeshTally();
+
+    void SetSourceRate(G4double rate)       { fSourceRate = rate; };
+    void SetDoseConversion(const FluenceToDose* dose) { fDose = dose; };
+
+    // origin: lower corner of the mesh; clears the sums (begin of run)
+    void Book(const G4ThreeVector& origin, const G4ThreeVector& voxelSize,
+              G4int nx, G4int ny, G4int nz);
+    G4bool IsBooked() const                 { return fNbVoxels > 0; };
+
+    // a step of length L (times weight) of a neutron or gamma in a voxel
+    inline void Score(G4int particle, G4int ix, G4int iy, G4int iz,
+                      G4double energy, G4double weightedLength);
+
+    void Merge(const MeshTally&);
+
+    // rates for nbEvents primaries at the source rate, per voxel
+    G4double GetFluenceRate(G4int particle, size_t voxel, G4int nbEvents) const;
+    G4double GetDoseRate(G4int particle, size_t voxel, G4int nbEvents) const;
+
+    // peak dose rate of each particle
+    void Print(G4int nbEvents) const;
+    // one line per scored voxel: ix,iy,iz, fluence and dose rates
+    G4bool Write(const G4String& fileName, G4int nbEvents) const;
+
+  private:
+    G4double      fSourceRate;              // primaries per second
+    const FluenceToDose* fDose;             // h(E) [pSv cm2]
+
+    G4ThreeVector fOrigin;
+    G4ThreeVector fVoxelSize;
+    G4int         fNx, fNy, fNz;
+    size_t        fNbVoxels;
+    std::vector<G4double> fLength;          // [particle][voxel], w*L
+    std::vector<G4double> fDoseSum;         // [particle][voxel], w*L*h
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void MeshTally::Score(G4int particle, G4int ix, G4int iy, G4int iz,
+                             G4double energy, G4double weightedLength)
+{
+  size_t i = particle*fNbVoxels + (size_t(ix)*fNy + iy)*fNz + iz;
+  fLength[i]  += weightedLength;
+  fDoseSum[i] += weightedLength*fDose->GetCoefficient(particle, energy);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
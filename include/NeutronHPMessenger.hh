@@ -39,6 +39,7 @@
 class NeutronHPphysics;
 class G4UIdirectory;
 class G4UIcmdWithABool;
+class G4UIcommand;
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -55,6 +56,9 @@ class NeutronHPMessenger: public G4UImessenger
     
     G4UIdirectory*     fPhysDir;      
     G4UIcmdWithABool*  fThermalCmd;
+    G4UIcommand*       fImplicitCmd;
+    G4UIcommand*       fCutoffCmd;
+    G4UIcommand*       fCaptureBiasCmd;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -35,8 +35,10 @@
 
 #include "globals.hh"
 #include "G4VPhysicsConstructor.hh"
+#include <map>
 
 class NeutronHPMessenger;
+class G4LogicalVolume;
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -52,10 +54,33 @@ class NeutronHPphysics : public G4VPhysicsConstructor
     
   public:
     void SetThermalPhysics(G4bool flag) {fThermal = flag;};  
+
+    // implicit capture of the neutrons in a logical volume (by name):
+    // no absorption, the weight carries the survival probability
+    void SetImplicitCapture(const G4String& volume, G4bool flag);
+    void SetWeightCutoff(G4double cutoff, G4double survival)
+                        {fWeightCutoff = cutoff; fSurvivalWeight = survival;};
+    G4double GetWeightCutoff() const   {return fWeightCutoff;};
+    G4double GetSurvivalWeight() const {return fSurvivalWeight;};
+
+    // capture cross section multiplied by factor in a material (by name),
+    // the weights corrected: more capture gammas, of smaller weight
+    void SetCaptureBias(const G4String& material, G4double factor);
+
+    // multiplier of the capture cross section in a volume, 1 if analog;
+    // implicit capture of the volume first, then its material
+    G4double GetCaptureFactor(const G4LogicalVolume*) const;
+    G4bool   HasCaptureBiasing() const
+               {return !fCaptureFactor.empty() || !fMaterialFactor.empty();};
     
   private:
     G4bool  fThermal;
     NeutronHPMessenger* fNeutronMessenger;  
+
+    std::map<G4String, G4double> fCaptureFactor;   //by volume name
+    std::map<G4String, G4double> fMaterialFactor;  //by material name
+    G4double fWeightCutoff;
+    G4double fSurvivalWeight;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
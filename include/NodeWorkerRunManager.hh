@@ -0,0 +1,109 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file NodeWorkerRunManager.hh
+/// \brief Definition of the NodeMerger and NodeWorkerRunManager classes
+//
+// Hierarchical merge of the runs of pinned workers (ThreadAffinity): the
+// workers of a NUMA node merge their Run into the Run of the first of
+// them to finish, under a lock of the node, and the last one merges the
+// node into the master run. The master lock is taken once per node
+// instead of once per thread, and the tallies cross the interconnect once.
+// The Run of a worker stays alive until its next run: the node sum is
+// kept there. Without a NodeMerger (threads not pinned) the merge is the
+// one of G4WorkerRunManager. Either is timed by the ChunkedRunManager.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef NodeWorkerRunManager_h
+#define NodeWorkerRunManager_h 1
+
+#include "G4Types.hh"
+
+#ifdef G4MULTITHREADED
+
+#include "G4WorkerRunManager.hh"
+#include "G4Version.hh"
+
+#include <mutex>
+#include <vector>
+
+class G4Run;
+class G4MTRunManager;
+class ThreadAffinity;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class NodeMerger
+{
+  public:
+    NodeMerger(const ThreadAffinity*);
+   ~NodeMerger();
+
+    // worker: merge its run into the sum of its node; the sum once all
+    // the threads of the node are in, 0 otherwise
+    const G4Run* Merge(G4Run* run, G4int thread, G4int nbThreads);
+
+  private:
+    struct Node {
+      Node() : sum(0), nbMerged(0) {};
+      std::mutex mutex;
+      G4Run*     sum;        //the run of the first worker in
+      G4int      nbMerged;
+    };
+
+    const ThreadAffinity* fAffinity;
+    std::vector<Node>     fNodes;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class NodeWorkerRunManager : public G4WorkerRunManager
+{
+  public:
+    NodeWorkerRunManager(NodeMerger*);   //0: merge straight to the master
+    virtual ~NodeWorkerRunManager();
+
+  protected:
+    // the events kept by the workers (none in this application) are only
+    // merged by the flat merge
+#if G4VERSION_NUMBER >= 1120
+    virtual void MergePartialResults(G4bool mergeEvents) override;
+#else
+    virtual void MergePartialResults() override;
+#endif
+
+  private:
+    void MergeThroughNode(G4MTRunManager*);
+
+    NodeMerger* fMerger;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
+#endif
@@ -0,0 +1,80 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file PhaseSpaceFormat.hh
+/// \brief Layout of the binary phase-space file
+//
+// A phase-space file is a FileHeader followed by fixed-size Records, one
+// per source particle (leaving the tank, or a gamma born in the neutron
+// phase), in the order the threads handed them over. The header keeps the
+// number of primaries of the recording run: a replayed record stands for
+// nbPrimaries/nbRecords of them.
+// Units: mm, MeV, ns. No Geant4 dependency.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef PhaseSpaceFormat_h
+#define PhaseSpaceFormat_h 1
+
+#include <cstddef>
+#include <cstdint>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+namespace PhaseSpaceFormat
+{
+  const char     kMagic[8] = { 'M','O','N','P','H','S','P','1' };
+  const uint32_t kVersion  = 2;
+
+  // what the records are: the tank exits (replay kills the particles
+  // entering the tank, their later exits being in the file) or gammas
+  // born inside it
+  enum Source { kTankExit = 0, kGammaSource = 1 };
+
+  struct FileHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t recordSize;   // sizeof(Record), checked by the reader
+    uint64_t nbRecords;    // written when the file is closed
+    double   nbPrimaries;  // events of the recording run
+    uint32_t source;       // Source
+    uint32_t reserved;
+  };
+
+  struct Record {
+    float   x, y, z;       // position [mm]
+    float   u, v, w;       // unit direction
+    float   energy;        // kinetic energy [MeV]
+    float   time;          // global time [ns]
+    float   weight;
+    int32_t pdg;           // PDG encoding of the particle
+  };
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,89 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file PhaseSpaceReader.hh
+/// \brief Definition of the PhaseSpaceReader class
+//
+// Source side of the surface source: the records of a phase-space file
+// (PhaseSpaceFormat.hh) are handed out one by one, under a lock, to the
+// primary generators of all threads, so that each record is used once per
+// pass over the file. The file is read by blocks and restarts from its
+// first record once exhausted, with a warning: the replayed run should not
+// ask for more records than the file holds.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef PhaseSpaceReader_h
+#define PhaseSpaceReader_h 1
+
+#include "globals.hh"
+#include "PhaseSpaceFormat.hh"
+
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class PhaseSpaceReader
+{
+  public:
+    static PhaseSpaceReader* Instance();
+
+    // the generator of each thread asks: a file already open is kept
+    G4bool Open(const G4String& fileName);
+    void   Close();
+    G4bool IsOpen() const { return fFile != 0; };
+
+    // thread safe: next record of the file, false if it has none
+    G4bool Next(PhaseSpaceFormat::Record&);
+
+    uint64_t GetNbRecords() const  { return fHeader.nbRecords; };
+    G4double GetNbPrimaries() const { return fHeader.nbPrimaries; };
+    // records of the tank exits, not a gamma source
+    G4bool   HoldsTankExits() const
+               { return fHeader.source == PhaseSpaceFormat::kTankExit; };
+
+  private:
+    PhaseSpaceReader();
+   ~PhaseSpaceReader();
+
+    G4bool ReadBlock();
+
+    std::mutex                  fMutex;
+    std::FILE*                  fFile;
+    G4String                    fFileName;
+    PhaseSpaceFormat::FileHeader fHeader;
+    std::vector<PhaseSpaceFormat::Record> fBlock;
+    size_t                      fNext, fSize;    // in the current block
+    uint64_t                    fNbRead;         // in the current pass
+    G4int                       fNbPasses;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,128 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file PhaseSpaceWriter.hh
+/// \brief Definition of the PhaseSpaceWriter and PhaseSpaceBuffer classes
+//
+// Surface-source recording: every particle leaving the Tank volume is
+// appended by the stepping action to a per-thread PhaseSpaceBuffer, whose
+// full blocks are written under a lock to the one file of the run
+// (PhaseSpaceFormat.hh). The master opens the file at begin of run and
+// closes it at end of run, once the workers have flushed, writing the
+// record count and the number of primaries into the header.
+// The file is the source of the later runs that only change what is
+// outside the tank (PrimaryGeneratorAction, /testhadr/gun/phaseSpace).
+// A second stream, in the same format, takes the secondary gammas of the
+// neutron transport, mostly of captures and inelastic scatterings
+// (StackingAction): the source of the gamma phase of a two-phase run.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef PhaseSpaceWriter_h
+#define PhaseSpaceWriter_h 1
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include "G4SystemOfUnits.hh"
+#include "PhaseSpaceFormat.hh"
+
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class PhaseSpaceWriter
+{
+  public:
+    enum Stream { kTankExit, kGammaSource };
+
+    static PhaseSpaceWriter* Instance(Stream stream = kTankExit);
+
+    // master: begin and end of run
+    void Open(const G4String& fileName);
+    void Close(G4double nbPrimaries);
+
+    G4bool IsOpen() const { return fFile != 0; };
+
+    // thread safe: called by the worker threads
+    void Write(const PhaseSpaceFormat::Record*, size_t n);
+
+  private:
+    PhaseSpaceWriter(const G4String& description, Stream);
+   ~PhaseSpaceWriter();
+
+    G4String    fDescription;
+    Stream      fStream;
+    std::mutex  fMutex;
+    std::FILE*  fFile;
+    G4String    fFileName;
+    uint64_t    fNbRecords;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class PhaseSpaceBuffer
+{
+  public:
+    PhaseSpaceBuffer(PhaseSpaceWriter::Stream stream = PhaseSpaceWriter::kTankExit,
+                     size_t capacity = 4096);
+   ~PhaseSpaceBuffer();
+
+    inline void Push(G4int pdg, const G4ThreeVector& position,
+                     const G4ThreeVector& direction, G4double energy,
+                     G4double time, G4double weight);
+
+    // hand all buffered records to the writer
+    void Flush();
+
+  private:
+    PhaseSpaceWriter*                     fWriter;
+    std::vector<PhaseSpaceFormat::Record> fRecords;   // allocated once
+    size_t                                fSize;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void PhaseSpaceBuffer::Push(G4int pdg, const G4ThreeVector& position,
+                                   const G4ThreeVector& direction,
+                                   G4double energy, G4double time,
+                                   G4double weight)
+{
+  PhaseSpaceFormat::Record& rec = fRecords[fSize];
+  rec.x = position.x()/mm; rec.y = position.y()/mm; rec.z = position.z()/mm;
+  rec.u = direction.x();   rec.v = direction.y();   rec.w = direction.z();
+  rec.energy = energy/MeV;
+  rec.time   = time/ns;
+  rec.weight = weight;
+  rec.pdg    = pdg;
+  if (++fSize == fRecords.size()) Flush();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
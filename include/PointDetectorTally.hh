@@ -0,0 +1,110 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file PointDetectorTally.hh
+/// \brief Definition of the PointDetectorTally class
+//
+// Dose rate at fixed points of the lab (test volumes TV1-TV4, the monitor)
+// from the next-event estimator of PointEstimator: each emission or
+// collision of a neutron or gamma adds the uncollided fluence it sends
+// to a point, w p(mu) exp(-tau)/(2 pi R^2), times h(E) (FluenceToDose).
+// A point needs no volume and scores from every collision of the run,
+// where a small test volume would only be reached by a few tracks.
+// The sums are summed per event for the relative error R and the figure
+// of merit, and added up in Run::Merge.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef PointDetectorTally_h
+#define PointDetectorTally_h 1
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include "FluenceToDose.hh"
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class PointDetectorTally
+{
+  public:
+    enum { kNbParticles = 2 };    // CrossingRecord::kNeutron, kGamma
+
+    PointDetectorTally();
+   ~PointDetectorTally();
+
+    void SetSourceRate(G4double rate)       { fSourceRate = rate; };
+    void SetDoseConversion(const FluenceToDose* dose) { fDose = dose; };
+
+    // the points of the run; clears the sums (begin of run)
+    void Book(const std::vector<G4ThreeVector>& points);
+    G4bool IsBooked() const                 { return !fPoint.empty(); };
+
+    G4int GetNbPoints() const               { return fPoint.size(); };
+    const G4ThreeVector& GetPoint(G4int i) const { return fPoint[i]; };
+
+    // fluence [1/cm2] sent to point i by a particle of this energy
+    inline void Score(G4int point, G4int particle, G4double fluence,
+                      G4double energy);
+
+    // accumulate the per-event dose of each point (end of event)
+    void EndOfEvent();
+
+    void Merge(const PointDetectorTally&);
+
+    // dose rate [microSv/h] at point i, for nbEvents primaries
+    G4double GetDoseRate(G4int point, G4int particle, G4int nbEvents) const;
+
+    // dose rates, relative errors and figures of merit, for a run of
+    // nbEvents primaries lasting time [s]
+    void Print(G4int nbEvents, G4double time) const;
+
+  private:
+    G4double   fSourceRate;                 // primaries per second
+    const FluenceToDose* fDose;             // h(E) [pSv cm2]
+
+    std::vector<G4ThreeVector> fPoint;
+    // [point*kNbParticles + particle]: dose of the event, sums over events
+    std::vector<G4double> fEventSum;
+    std::vector<G4double> fSum1;
+    std::vector<G4double> fSum2;
+    G4bool     fEventScored;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void PointDetectorTally::Score(G4int point, G4int particle,
+                                      G4double fluence, G4double energy)
+{
+  fEventSum[point*kNbParticles + particle]
+    += fluence*fDose->GetCoefficient(particle, energy);
+  fEventScored = true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
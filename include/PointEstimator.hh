@@ -0,0 +1,154 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file PointEstimator.hh
+/// \brief Definition of the PointEstimator class
+//
+// Next-event estimator of the point detectors (PointDetectorTally). At
+// each emission or collision of a neutron or gamma, the fluence it would
+// send uncollided to each point is
+//     w p(mu) exp(-tau(E')) / (2 pi R^2)
+// p(mu) being the pdf of the cosine mu between the incident direction
+// and the point, E' the energy the particle has in that direction, and
+// tau the optical thickness along the ray, ray-traced through the mass
+// geometry with the total macroscopic cross section of the particle at E'.
+// The laws, in the lab:
+//  - emission: isotropic (source, capture, decay, inelastic secondaries);
+//  - neutron elastic scattering: isotropic in the centre of mass on a
+//    nucleus at rest, A being the one hit; for hydrogen p(mu) = 2 mu,
+//    forward only, and E' = E mu^2;
+//  - Compton scattering: Klein-Nishina, on free electrons at rest;
+//  - Rayleigh scattering: Thomson, E' = E;
+//  - others, and elastic scattering below kThermalCutoff (molecular
+//    binding and target motion), isotropic with E' = E.
+// The scores made with an isotropic law in place of the process one
+// (last case, and bremsstrahlung emission) are counted and printed.
+// Ray tracing is the cost of the estimator, so the materials and lengths
+// crossed by a ray are cached per point and per cell of a cubic grid of
+// origins: rays from the same cell reuse the path traced from the cell
+// centre, and only the cross sections change with the energy. The cross
+// sections are tabulated once per material on a log-energy grid.
+// One estimator per thread (RunAction), with its own navigator.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef PointEstimator_h
+#define PointEstimator_h 1
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+class PointDetectorTally;
+class G4Material;
+class G4VProcess;
+class G4Navigator;
+class G4VPhysicalVolume;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class PointEstimator
+{
+  public:
+    enum { kNbParticles = 2 };    // CrossingRecord::kNeutron, kGamma
+
+    PointEstimator();
+   ~PointEstimator();
+
+    // geometry and tally of the run; R is clamped to minDistance, rays
+    // are cached on cells of cacheCell (0: every ray traced)
+    void BeginOfRun(G4VPhysicalVolume* world, PointDetectorTally*,
+                    G4double minDistance, G4double cacheCell);
+
+    // emission of a particle of this energy and weight by a process
+    // (0: the source)
+    void ScoreEmission(G4int particle, const G4VProcess* creator,
+                       const G4ThreeVector& position,
+                       G4double energy, G4double weight);
+
+    // collision survived by a particle, by a hadronic or electromagnetic
+    // process (others ignored); direction and energy before it
+    void ScoreCollision(G4int particle, const G4VProcess*,
+                        const G4ThreeVector& position,
+                        const G4ThreeVector& direction,
+                        G4double energy, G4double weight);
+
+    // rays traced and rays taken from the cache since the begin of run
+    G4double GetNbTraced() const            { return fNbTraced; };
+    G4double GetNbCached() const            { return fNbCached; };
+    // scores made, and with an isotropic law in place of the process one
+    G4double GetNbScored() const            { return fNbScored; };
+    G4double GetNbIsotropic() const         { return fNbIsotropic; };
+
+  private:
+    enum Law { kIsotropic, kElastic, kCompton, kRayleigh };
+
+    // pdf of mu per unit mu, and energy after the scattering
+    static G4double Scatter(Law, G4double energy, G4double targetA,
+                            G4double mu, G4double& outEnergy);
+    static G4double KleinNishina(G4double k);
+    // exp(-tau) from position to point i, at this energy
+    G4double Attenuation(G4int point, G4int particle,
+                         const G4ThreeVector& position, G4double distance,
+                         G4double energy);
+
+    struct Segment {
+      const G4Material* material;
+      G4double          length;
+    };
+    typedef std::vector<Segment> Path;
+
+    const Path& GetPath(G4int point, const G4ThreeVector& from);
+    void     Trace(const G4ThreeVector& from, const G4ThreeVector& to, Path&);
+    G4double GetCrossSection(G4int particle, const G4Material*, G4double energy);
+    void     BuildTable(G4int particle, const G4Material*, std::vector<G4double>&);
+
+    G4Navigator*        fNavigator;
+    PointDetectorTally* fTally;
+    G4double            fMinDistance;
+    G4double            fCacheCell;
+
+    // per point: packed cell indices -> path from the cell centre
+    std::vector<std::unordered_map<uint64_t, Path> > fCache;
+    Path                fScratch;
+    G4double            fNbTraced, fNbCached;
+    G4double            fNbScored, fNbIsotropic;
+
+    // total cross section [1/mm] of a material on the log-energy grid
+    std::map<const G4Material*, std::vector<G4double> > fTable[kNbParticles];
+    G4double            fLogEmin[kNbParticles];
+    G4double            fInvStep[kNbParticles];
+    G4int               fNbNodes[kNbParticles];
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
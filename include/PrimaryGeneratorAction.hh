@@ -40,8 +40,12 @@
 #include "G4ParticleGun.hh"
 #include "globals.hh"
 #include "DetectorConstruction.hh"
+#include "AliasTable.hh"
+#include "PhaseSpaceFormat.hh"
+#include <vector>
 
 class G4Event;
+class PrimaryGeneratorMessenger;
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -56,9 +60,53 @@ class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction
     virtual void GeneratePrimaries(G4Event*);
     const G4ParticleGun* GetParticleGun() const {return fParticleGun;};
 
+    // angular biasing of the isotropic source: a pdf constant over bins
+    // uniform in cos(theta) and phi, read from a CadisTool file and/or
+    // raised by a factor in cones; the primaries carry the ratio of the
+    // isotropic to the biased pdf as weight
+    G4bool LoadAngularBias(const G4String& fileName);
+    void   SetAngularBins(G4int nbCos, G4int nbPhi);
+    void   AddBiasCone(const G4ThreeVector& axis, G4double halfAngle,
+                       G4double factor);
+    void   ClearAngularBias();
+
+    // surface source: the particles leaving the tank in a recording run
+    // (/testhadr/output/phaseSpace) are the primaries, each used for
+    // 'reuse' consecutive events with its position spread over the face
+    // of the tank by a gaussian of width 'smear'. A record weighs
+    // nbPrimaries/nbRecords of the recording run times its own weight
+    G4bool LoadPhaseSpace(const G4String& fileName, G4int reuse, G4double smear);
+    void   ClearPhaseSpace();
+    G4bool HasPhaseSpace() const { return fPhaseSpace; };
+    // the file holds the tank exits: the replay kills the particles
+    // entering the tank, whose later exits are records of their own
+    G4bool ReplaysTankExits() const;
+
   private:
     G4ParticleGun*  fParticleGun;        //pointer a to G4 service class
     const DetectorConstruction* fDetector;
+    PrimaryGeneratorMessenger*  fGunMessenger;
+
+    struct BiasCone {
+      G4ThreeVector axis;
+      G4double      cosHalf;
+      G4double      factor;
+    };
+    void UpdateAngularBias();
+    void GeneratePhaseSpacePrimary(G4Event*);
+
+    G4int                  fNbCos, fNbPhi;
+    std::vector<G4double>  fBasePdf;     //from file, empty if isotropic
+    std::vector<BiasCone>  fCones;
+    AliasTable             fBiasTable;
+    std::vector<G4double>  fBiasWeight;
+
+    G4bool                     fPhaseSpace;
+    G4int                      fReuse;
+    G4double                   fSmear;
+    G4double                   fRecordWeight;  //nbRecords/nbPrimaries
+    PhaseSpaceFormat::Record   fRecord;        //of this thread
+    G4int                      fUsesLeft;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -36,7 +36,13 @@
 #include "G4Run.hh"
 #include "G4VProcess.hh"
 #include "globals.hh"
-#include <map>
+#include "DenseCounter.hh"
+#include "SurfaceTally.hh"
+#include "MeshTally.hh"
+#include "SparseMeshTally.hh"
+#include "WindowFluxTally.hh"
+#include "PointDetectorTally.hh"
+#include <vector>
 
 class DetectorConstruction;
 class G4ParticleDefinition;
@@ -50,9 +56,15 @@ class Run : public G4Run
    ~Run();
 
   public:
-    void CountProcesses(const G4VProcess* process);                  
-    void ParticleCount(G4String, G4double);
+    inline void CountProcesses(const G4VProcess* process);                  
+    inline void ParticleCount(const G4ParticleDefinition*, G4double);
     void SumTrackLength (G4int,G4int,G4double,G4double,G4double,G4double);
+    void CountStepAllocations(size_t nbAlloc);
+    SurfaceTally* GetSurfaceTally() { return &fSurfaceTally; };
+    MeshTally*    GetMeshTally()    { return &fMeshTally; };
+    SparseMeshTally* GetSparseMesh() { return &fSparseMesh; };
+    WindowFluxTally* GetWindowFlux() { return &fWindowFlux; };
+    PointDetectorTally* GetPointTally() { return &fPointTally; };
     
     void SetPrimary(G4ParticleDefinition* particle, G4double energy);    
     void EndOfRun(); 
@@ -60,31 +72,71 @@ class Run : public G4Run
     virtual void Merge(const G4Run*);
    
   private:
-    struct ParticleData {
-     ParticleData()
-       : fCount(0), fEmean(0.), fEmin(0.), fEmax(0.) {}
-     ParticleData(G4int count, G4double ekin, G4double emin, G4double emax)
-       : fCount(count), fEmean(ekin), fEmin(emin), fEmax(emax) {}
-     G4int     fCount;
-     G4double  fEmean;
-     G4double  fEmin;
-     G4double  fEmax;
-    };
-     
+    G4int RegisterProcess(const G4VProcess*);
+    G4int RegisterParticle(const G4ParticleDefinition*);
+    void  ResizeParticleData(size_t);
+
   private:
     DetectorConstruction* fDetector;
     G4ParticleDefinition* fParticle;
     G4double              fEkin;
         
-    std::map<G4String,G4int>        fProcCounter;            
-    std::map<G4String,ParticleData> fParticleDataMap;
+    // processes and particles are registered once to dense IDs shared
+    // by all threads; names are only looked up again for printing
+    static NameRegistry fgProcessNames;
+    static NameRegistry fgParticleNames;
+
+    PointerIndex          fProcIndex;
+    std::vector<G4int>    fProcCounter;
+
+    PointerIndex          fParticleIndex;
+    std::vector<G4int>    fPartCount;
+    std::vector<G4double> fPartEsum;
+    std::vector<G4double> fPartEmin;
+    std::vector<G4double> fPartEmax;
         
     G4int    fNbStep1, fNbStep2;
     G4double fTrackLen1, fTrackLen2;
     G4double fTime1, fTime2;    
+
+    // heap allocations made in SteppingAction (MONITOR_COUNT_ALLOCATIONS)
+    G4double fNbSteps, fNbStepAllocs, fNbStepsWithAllocs;
+
+    // dose-rate maps of the lab walls
+    SurfaceTally fSurfaceTally;
+    // dose-rate mesh of the room (ScoringWorld)
+    MeshTally    fMeshTally;
+    // fine sparse mesh of the room (SteppingAction)
+    SparseMeshTally fSparseMesh;
+    // pilot-run fluence of the weight-window cells (WeightWindowSD)
+    WindowFluxTally fWindowFlux;
+    // dose at the point detectors (PointEstimator)
+    PointDetectorTally fPointTally;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+inline void Run::CountProcesses(const G4VProcess* process)
+{
+  G4int id = fProcIndex.Find(process);
+  if (id < 0) id = RegisterProcess(process);
+  fProcCounter[id]++;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline void Run::ParticleCount(const G4ParticleDefinition* particle,
+                               G4double Ekin)
+{
+  G4int id = fParticleIndex.Find(particle);
+  if (id < 0) id = RegisterParticle(particle);
+  fPartCount[id]++;
+  fPartEsum[id] += Ekin;
+  if (Ekin < fPartEmin[id]) fPartEmin[id] = Ekin;
+  if (Ekin > fPartEmax[id]) fPartEmax[id] = Ekin;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 #endif
 
@@ -35,6 +35,7 @@
 
 #include "G4UserRunAction.hh"
 #include "globals.hh"
+#include "G4Timer.hh"
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -42,6 +43,11 @@ class DetectorConstruction;
 class Run;
 class PrimaryGeneratorAction;
 class HistoManager;
+class SteppingAction;
+class StackingAction;
+class CrossingBuffer;
+class PointEstimator;
+class PhaseSpaceBuffer;
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -55,12 +61,25 @@ class RunAction : public G4UserRunAction
     virtual G4Run* GenerateRun();  
     virtual void BeginOfRunAction(const G4Run*);
     virtual void   EndOfRunAction(const G4Run*);
+
+    void SetSteppingAction(SteppingAction* stepping) { fSteppingAction = stepping; };
+    void SetStackingAction(StackingAction* stacking) { fStackingAction = stacking; };
+    Run*            GetRun()            { return fRun; };
+    CrossingBuffer* GetCrossingBuffer() { return fCrossingBuffer; };
+    HistoManager*   GetHistoManager()   { return fHistoManager; };
                             
   private:
     DetectorConstruction*      fDetector;
     PrimaryGeneratorAction*    fPrimary;
     Run*                       fRun;    
     HistoManager*              fHistoManager;
+    SteppingAction*            fSteppingAction;
+    StackingAction*            fStackingAction;
+    CrossingBuffer*            fCrossingBuffer;
+    PointEstimator*            fPointEstimator;
+    PhaseSpaceBuffer*          fPhaseSpaceBuffer;
+    PhaseSpaceBuffer*          fGammaSourceBuffer;
+    G4Timer                    fRunTimer;     //master: duration of the run
         
 };
 
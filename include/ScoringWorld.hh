@@ -0,0 +1,76 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file ScoringWorld.hh
+/// \brief Definition of the ScoringWorld class
+//
+// Parallel world holding the voxel mesh of the dose-rate tally: a box
+// over the Room volume divided by replicas along x, y and z, the voxels
+// being read by MeshSD. The mass geometry and its navigation are left
+// unchanged (G4ParallelWorldPhysics in PhysicsList).
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef ScoringWorld_h
+#define ScoringWorld_h 1
+
+#include "G4VUserParallelWorld.hh"
+#include "G4ThreeVector.hh"
+#include "globals.hh"
+
+class DetectorConstruction;
+class G4LogicalVolume;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class ScoringWorld : public G4VUserParallelWorld
+{
+  public:
+    ScoringWorld(const G4String& worldName, DetectorConstruction*);
+   ~ScoringWorld();
+
+    virtual void Construct();
+    virtual void ConstructSD();
+
+    // nb of voxels along x, y, z; 0: no mesh (default)
+    void SetNbVoxels(G4int nx, G4int ny, G4int nz);
+    G4bool HasMesh() const      { return fNbVoxels[0]*fNbVoxels[1]*fNbVoxels[2] > 0; };
+    G4int GetNbVoxels(G4int axis) const { return fNbVoxels[axis]; };
+    // lower corner of the mesh and size of a voxel, set by Construct()
+    const G4ThreeVector& GetMeshOrigin() const { return fOrigin; };
+    const G4ThreeVector& GetVoxelSize() const  { return fVoxelSize; };
+
+  private:
+    DetectorConstruction* fDetector;
+    G4int                 fNbVoxels[3];
+    G4ThreeVector         fOrigin;
+    G4ThreeVector         fVoxelSize;
+    G4LogicalVolume*      fVoxelL;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
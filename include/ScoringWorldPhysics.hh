@@ -0,0 +1,65 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file ScoringWorldPhysics.hh
+/// \brief Definition of the ScoringWorldPhysics class
+//
+// Navigation in the ScoringWorld of the dose-rate mesh. The mesh is set by
+// /testhadr/det/setMesh after the physics list is made, so the parallel
+// world process is only added by ConstructProcess, when the mesh is on:
+// runs without a mesh do not pay for the parallel navigation.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef ScoringWorldPhysics_h
+#define ScoringWorldPhysics_h 1
+
+#include "G4VPhysicsConstructor.hh"
+#include "globals.hh"
+
+class ScoringWorld;
+class G4ParallelWorldPhysics;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class ScoringWorldPhysics : public G4VPhysicsConstructor
+{
+  public:
+    ScoringWorldPhysics(ScoringWorld*);
+   ~ScoringWorldPhysics();
+
+    virtual void ConstructParticle() { };
+    virtual void ConstructProcess();
+
+  private:
+    ScoringWorld*             fWorld;
+    G4ParallelWorldPhysics*   fParallelWorld;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
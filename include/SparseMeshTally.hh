@@ -0,0 +1,142 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file SparseMeshTally.hh
+/// \brief Definition of the SparseMeshTally class
+//
+// Fine track-length mesh of the room that only stores the voxels actually
+// crossed: an open-addressing hash table keyed by the packed voxel
+// indices, filled by a 3D DDA walk of each neutron and gamma step
+// (SteppingAction), without any volume in the geometry. Memory grows with
+// the scored volume, not with the room; threads merge by re-inserting
+// the occupied slots.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef SparseMeshTally_h
+#define SparseMeshTally_h 1
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include "FluenceToDose.hh"
+
+#include <cstdint>
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class SparseMeshTally
+{
+  public:
+    enum { kNbParticles = 2 };    // CrossingRecord::kNeutron, kGamma
+
+    SparseMeshTally();
+   ~SparseMeshTally();
+
+    void SetSourceRate(G4double rate)       { fSourceRate = rate; };
+    void SetDoseConversion(const FluenceToDose* dose) { fDose = dose; };
+
+    // cubic voxels of voxelSize over the box [origin, origin+size];
+    // clears the table (begin of run)
+    void Book(const G4ThreeVector& origin, const G4ThreeVector& size,
+              G4double voxelSize);
+    G4bool IsBooked() const                 { return fVoxelSize > 0.; };
+
+    // straight step of a neutron or gamma from start to end
+    void ScoreSegment(G4int particle, const G4ThreeVector& start,
+                      const G4ThreeVector& end, G4double energy,
+                      G4double weight);
+
+    void Merge(const SparseMeshTally&);
+
+    size_t GetNbVoxels() const              { return fSize; };
+
+    // occupancy and peak dose rate of each particle
+    void Print(G4int nbEvents) const;
+    // same format as MeshTally::Write
+    G4bool Write(const G4String& fileName, G4int nbEvents) const;
+
+  private:
+    struct Voxel {
+      uint64_t key;                        // kEmpty: free slot
+      G4double length[kNbParticles];       // w*L
+      G4double dose[kNbParticles];         // w*L*h
+    };
+
+    static const uint64_t kEmpty = ~uint64_t(0);
+    static const size_t   kInitialSize = 1024;
+
+    // ix in the high bits: keys sort in the order of MeshTally::Write
+    static inline uint64_t Key(G4int ix, G4int iy, G4int iz)
+    { return (uint64_t(ix) << 42) | (uint64_t(iy) << 21) | uint64_t(iz); };
+
+    static inline size_t Hash(uint64_t key)
+    {
+      key ^= key >> 29;
+      key *= 0x9E3779B97F4A7C15ULL;
+      return size_t(key >> 32);
+    }
+
+    // voxel of key, inserted empty if not found
+    inline Voxel& Get(uint64_t key);
+    void Grow();
+
+    G4double      fSourceRate;
+    const FluenceToDose* fDose;
+
+    G4ThreeVector fOrigin;
+    G4double      fVoxelSize;
+    G4int         fNbVoxels[3];            // along x, y, z
+
+    std::vector<Voxel> fVoxels;
+    size_t             fMask;
+    size_t             fSize;              // occupied slots
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline SparseMeshTally::Voxel& SparseMeshTally::Get(uint64_t key)
+{
+  size_t slot = Hash(key) & fMask;
+  while (fVoxels[slot].key != key) {
+    if (fVoxels[slot].key == kEmpty) {
+      if (2*(fSize+1) > fVoxels.size()) {
+        Grow();
+        return Get(key);
+      }
+      Voxel& voxel = fVoxels[slot];
+      voxel.key = key;
+      ++fSize;
+      return voxel;
+    }
+    slot = (slot + 1) & fMask;
+  }
+  return fVoxels[slot];
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
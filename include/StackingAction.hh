@@ -36,6 +36,8 @@
 #include "G4UserStackingAction.hh"
 #include "globals.hh"
 
+class PhaseSpaceBuffer;
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 class StackingAction : public G4UserStackingAction
@@ -45,6 +47,14 @@ class StackingAction : public G4UserStackingAction
    ~StackingAction();
      
     virtual G4ClassificationOfNewTrack ClassifyNewTrack(const G4Track*);
+
+    // neutron phase of a two-phase run: the secondary gammas go to the
+    // gamma source instead of the waiting stack
+    // (0: gammas transported); called at begin of each run
+    void BeginOfRun(PhaseSpaceBuffer* gammaSource) { fGammaSource = gammaSource; };
+
+  private:
+    PhaseSpaceBuffer* fGammaSource;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -39,7 +39,18 @@
 #include "EventAction.hh"
 #include "TrackingAction.hh"
 
+#include <vector>
+
 class TrackingAction;
+class Run;
+class CrossingBuffer;
+class SurfaceTally;
+class SparseMeshTally;
+class G4LogicalVolume;
+class G4ParticleDefinition;
+class CaptureBiasingOperator;
+class PointEstimator;
+class PhaseSpaceBuffer;
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -50,11 +61,39 @@ class SteppingAction : public G4UserSteppingAction
    ~SteppingAction();
 
     virtual void UserSteppingAction(const G4Step*);
+
+    // resolve the per-thread dispatch tables; called at begin of each run
+    void BeginOfRun(Run*, CrossingBuffer*, PointEstimator*, PhaseSpaceBuffer*,
+                    G4bool killTankEntries);
     
   private:
+    // codes of the logical volumes taking part in a scored boundary
+    enum VolumeCode   { kOtherVolume, kWorldVolume, kRoomVolume, kTankVolume,
+                        kNbVolumeCodes };
+    enum BoundaryCode { kNoBoundary, kRoomExit, kTankExit, kTankEntry };
+
+    void ScoreStep(const G4Step*);
+    void ScorePoints(const G4Step*);
+    void PlayRoulette(const G4Step*);
+    G4int GetVolumeCode(const G4LogicalVolume*) const;
+    void SetVolumeCode(const G4LogicalVolume*, G4int code, G4bool daughters);
+
     EventAction* fEventAction;
     TrackingAction* fTrackingAction;
     const DetectorConstruction* fDetector;
+
+    Run* fRun;
+    CrossingBuffer* fCrossings;         //0: crossings not written
+    SurfaceTally* fSurfaceTally;        //0: no wall dose maps
+    SparseMeshTally* fSparseMesh;       //0: no sparse mesh
+    PointEstimator* fPointEstimator;    //0: no point detectors
+    PhaseSpaceBuffer* fPhaseSpace;      //0: tank exits not recorded
+    G4bool fKillTankEntries;            //replay of the tank exits
+    const G4ParticleDefinition* fNeutron;
+    const G4ParticleDefinition* fGamma;
+    std::vector<G4int> fVolumeCode;     //indexed by logical volume instance ID
+    std::vector<const CaptureBiasingOperator*> fRoulette;  //idem, 0: analog
+    G4bool fHasRoulette;
 };
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,137 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file SurfaceTally.hh
+/// \brief Definition of the SurfaceTally class
+//
+// Dose-rate maps of the lab walls and ceiling, scored while the run goes
+// on from the particles leaving the Room volume. Each face is a 2D grid
+// of square bins; a crossing adds w*h(E)/|cos| to its bin, h being the
+// fluence-to-dose coefficient of the particle (FluenceToDose), so that
+// sum/area is the dose per source particle (surface-crossing estimate
+// of the fluence).
+// The sums are flat per-thread arrays, added up in Run::Merge.
+// The dose of each face is also summed per event, to estimate its
+// relative error R and the figure of merit 1/(R^2 T) of biased runs.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef SurfaceTally_h
+#define SurfaceTally_h 1
+
+#include "globals.hh"
+#include "G4ThreeVector.hh"
+#include <vector>
+
+class FluenceToDose;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class SurfaceTally
+{
+  public:
+    // the floor is not scored: it lies on the world boundary
+    enum Face { kNorth, kEast, kSouth, kWest, kCeiling, kNbFaces };
+    enum { kNbParticles = 2 };    // CrossingRecord::kNeutron, kGamma
+
+    SurfaceTally();
+   ~SurfaceTally();
+
+    // settings, applied by the next Book()
+    void SetBinSize(G4double size)          { fBinSize = size; };
+    void SetSourceRate(G4double rate)       { fSourceRate = rate; };
+    void SetDoseConversion(const FluenceToDose* dose) { fDose = dose; };
+
+    // lay the faces out on the room box and clear the sums (begin of run)
+    void Book(const G4ThreeVector& roomCenter, const G4ThreeVector& roomSize);
+    G4bool IsBooked() const                 { return !fSum.empty(); };
+
+    // a neutron or gamma leaving the room at position, along direction
+    void Score(G4int particle, const G4ThreeVector& position,
+               const G4ThreeVector& direction, G4double energy,
+               G4double weight);
+
+    // accumulate the per-event dose of each face (end of event)
+    void EndOfEvent();
+
+    void Merge(const SurfaceTally&);
+
+    // binning of a face: (u,v) are global coordinates along the face
+    G4int    GetNbBinsU(G4int face) const   { return fFace[face].nbU; };
+    G4int    GetNbBinsV(G4int face) const   { return fFace[face].nbV; };
+    G4double GetUMin(G4int face) const      { return fFace[face].uMin; };
+    G4double GetVMin(G4int face) const      { return fFace[face].vMin; };
+    G4double GetUMax(G4int face) const;
+    G4double GetVMax(G4int face) const;
+    G4double GetBinSize() const             { return fBinSize; };
+    G4double GetSourceRate() const          { return fSourceRate; };
+    G4int    GetUAxis(G4int face) const     { return fFace[face].uAxis; };
+    G4int    GetVAxis(G4int face) const     { return fFace[face].vAxis; };
+
+    // dose rate [microSv/h] in bin (iu,iv) of a face, for nbEvents primaries
+    G4double GetDoseRate(G4int particle, G4int face, G4int iu, G4int iv,
+                         G4int nbEvents) const;
+
+    static const char* GetFaceName(G4int face);
+
+    // peak and mean dose rate of each face
+    void Print(G4int nbEvents) const;
+    // relative error and figure of merit of the dose of each face,
+    // for a run of nbEvents primaries lasting time [s]
+    void PrintFigureOfMerit(G4int nbEvents, G4double time) const;
+
+  private:
+    struct FaceLayout {
+      G4int    axis;        // normal axis (0,1,2) of the face
+      G4int    uAxis, vAxis;
+      G4double uMin, vMin;
+      G4int    nbU, nbV;
+      size_t   offset;      // first bin of the face in the sums
+    };
+
+    G4double* Sums(G4int particle)  { return fSum.data() + particle*fNbBins; };
+    const G4double* Sums(G4int particle) const
+                                    { return fSum.data() + particle*fNbBins; };
+
+    G4double   fBinSize;
+    G4double   fSourceRate;                 // primaries per second
+    const FluenceToDose* fDose;             // h(E) [pSv cm2]
+
+    G4ThreeVector fCenter;
+    G4ThreeVector fHalfSize;
+    FaceLayout    fFace[kNbFaces];
+    size_t        fNbBins;                  // bins of all faces
+    std::vector<G4double> fSum;             // [particle][face bins]
+
+    // dose of each face in the current event, and its sums over events
+    G4double fEventSum[kNbParticles][kNbFaces];
+    G4double fSum1[kNbParticles][kNbFaces];
+    G4double fSum2[kNbParticles][kNbFaces];
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,80 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file ThreadAffinity.hh
+/// \brief Definition of the ThreadAffinity class
+//
+// Placement of the worker threads on the CPUs (-pin of Monitor):
+//   compact : the CPUs of NUMA node 0 first, then node 1, ...
+//   scatter : round robin over the nodes
+//   list    : explicit CPUs, e.g. 0-15,32-47, used in turn
+// The topology is read from /sys (Linux); elsewhere, or if it cannot be
+// read, all CPUs are taken on one node and the threads are not pinned.
+// The node of a thread groups the workers of the hierarchical merge
+// (NodeWorkerRunManager).
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef ThreadAffinity_h
+#define ThreadAffinity_h 1
+
+#include "globals.hh"
+
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class ThreadAffinity
+{
+  public:
+    ThreadAffinity(const G4String& policy);
+   ~ThreadAffinity();
+
+    G4bool IsValid() const      { return !fCpus.empty(); };
+    G4int  GetNbNodes() const   { return fNbNodes; };
+    // CPU and NUMA node of worker thread i
+    G4int  GetCpu(G4int thread) const;
+    G4int  GetNode(G4int thread) const;
+
+    // pin the calling thread to the CPU of worker thread i
+    G4bool Pin(G4int thread) const;
+
+    void   Print(G4int nbThreads) const;
+
+  private:
+    void ReadTopology();
+    static std::vector<G4int> ParseList(const G4String&);
+
+    G4String           fPolicy;
+    std::vector<G4int> fNodeOfCpu;   //indexed by CPU number, -1: offline
+    std::vector<G4int> fCpus;        //in the order given to the threads
+    G4int              fNbNodes;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
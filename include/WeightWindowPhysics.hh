@@ -0,0 +1,73 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file WeightWindowPhysics.hh
+/// \brief Definition of the WeightWindowPhysics class
+//
+// Navigation in the WeightWindowWorld, when its mesh is set (pilot runs
+// score in its cells), and splitting/roulette of the neutrons against the
+// windows of the cells (G4WeightWindowBiasing), when they are loaded.
+// The algorithm parameters are only known once the macro has been read:
+// the biasing constructor is made by the first (master) ConstructProcess
+// and shared by the workers.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef WeightWindowPhysics_h
+#define WeightWindowPhysics_h 1
+
+#include "G4VPhysicsConstructor.hh"
+#include "globals.hh"
+
+class WeightWindowWorld;
+class G4GeometrySampler;
+class G4WeightWindowAlgorithm;
+class G4WeightWindowBiasing;
+class G4ParallelWorldPhysics;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class WeightWindowPhysics : public G4VPhysicsConstructor
+{
+  public:
+    WeightWindowPhysics(WeightWindowWorld*);
+   ~WeightWindowPhysics();
+
+    virtual void ConstructParticle() { };
+    virtual void ConstructProcess();
+
+  private:
+    WeightWindowWorld*        fWorld;
+    G4ParallelWorldPhysics*   fParallelWorld;
+    G4GeometrySampler*        fSampler;
+    G4WeightWindowAlgorithm*  fAlgorithm;
+    G4WeightWindowBiasing*    fBiasing;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
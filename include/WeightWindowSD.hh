@@ -0,0 +1,67 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file WeightWindowSD.hh
+/// \brief Definition of the WeightWindowSD class
+//
+// Sensitive detector of the cells of WeightWindowWorld: during a pilot
+// run, adds the weighted track length of each neutron step to the
+// WindowFluxTally of the current Run, given by RunAction at begin of run.
+// The detector is deactivated in the other runs. No hits are created.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef WeightWindowSD_h
+#define WeightWindowSD_h 1
+
+#include "G4VSensitiveDetector.hh"
+#include "globals.hh"
+
+class WindowFluxTally;
+class G4ParticleDefinition;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class WeightWindowSD : public G4VSensitiveDetector
+{
+  public:
+    WeightWindowSD(const G4String& name);
+   ~WeightWindowSD();
+
+    // fluence tally of a pilot run (thread local); 0: not a pilot run
+    void BeginOfRun(WindowFluxTally*);
+
+    virtual G4bool ProcessHits(G4Step*, G4TouchableHistory*);
+
+  private:
+    WindowFluxTally*            fFlux;
+    const G4ParticleDefinition* fNeutron;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
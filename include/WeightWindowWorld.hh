@@ -0,0 +1,128 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file WeightWindowWorld.hh
+/// \brief Definition of the WeightWindowWorld class
+//
+// Parallel world of the weight windows: a box over the Room volume (room
+// and tank) tiled with nx*ny*nz cells, one placement per cell so that
+// each is a distinct geometry cell of the G4WeightWindowStore. Each cell
+// and neutron energy group has a lower weight bound wl; the survival and
+// upper bounds are survival*wl and upper*wl (WeightWindowPhysics).
+// The windows are generated from the neutron fluence of a pilot run:
+// wl = phi/phi_ref/survival, phi_ref being the largest fast fluence, so
+// that a source neutron of weight 1 sits at the survival weight and the
+// particle population is roughly flat across the room. They are written
+// to a text file and loaded from it before /run/initialize.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef WeightWindowWorld_h
+#define WeightWindowWorld_h 1
+
+#include "G4VUserParallelWorld.hh"
+#include "G4ThreeVector.hh"
+#include "G4PlaceOfAction.hh"
+#include "globals.hh"
+#include <vector>
+
+class DetectorConstruction;
+class WeightWindowMessenger;
+class WindowFluxTally;
+class G4LogicalVolume;
+class G4VPhysicalVolume;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class WeightWindowWorld : public G4VUserParallelWorld
+{
+  public:
+    WeightWindowWorld(const G4String& worldName, DetectorConstruction*);
+   ~WeightWindowWorld();
+
+    virtual void Construct();
+    virtual void ConstructSD();
+
+    // nb of cells along x, y, z; 0: no mesh (default)
+    void SetNbCells(G4int nx, G4int ny, G4int nz);
+    G4bool HasMesh() const         { return fNbCells[0]*fNbCells[1]*fNbCells[2] > 0; };
+    G4int  GetNbCells() const      { return fNbCells[0]*fNbCells[1]*fNbCells[2]; };
+    G4int  GetNbCells(G4int axis) const { return fNbCells[axis]; };
+    // lower corner of the mesh and size of a cell, set by Construct()
+    const G4ThreeVector& GetMeshOrigin() const { return fOrigin; };
+    const G4ThreeVector& GetCellSize() const   { return fCellSize; };
+
+    // parameters of the splitting/roulette, fixed at /run/initialize
+    void SetUpperFactor(G4double f)     { fUpperFactor = f; };
+    void SetSurvivalFactor(G4double f)  { fSurvivalFactor = f; };
+    void SetMaxSplits(G4int n)          { fMaxSplits = n; };
+    void SetPlaceOfAction(G4PlaceOfAction place) { fPlace = place; };
+    G4double GetUpperFactor() const     { return fUpperFactor; };
+    G4double GetSurvivalFactor() const  { return fSurvivalFactor; };
+    G4int    GetMaxSplits() const       { return fMaxSplits; };
+    G4PlaceOfAction GetPlaceOfAction() const { return fPlace; };
+
+    // windows read from a file; the biasing is on once they are loaded
+    G4bool LoadWindows(const G4String& fileName);
+    G4bool HasWindows() const           { return !fLowerWeight.empty(); };
+
+    // the next runs are pilot runs: their fluence gives the windows,
+    // written to fileName by the master at end of run
+    void SetGenerationFile(const G4String& fileName) { fGenerationFile = fileName; };
+    G4bool IsGenerating() const         { return HasMesh() && fGenerationFile != ""; };
+    void GenerateWindows(const WindowFluxTally&);
+
+    // copy the windows into the G4WeightWindowStore of the calling thread
+    void UpdateWindowStore();
+
+    // lowerWeight: [cell][group], in the format read by LoadWindows
+    G4bool WriteWindows(const G4String& fileName,
+                        const std::vector<G4double>& lowerWeight) const;
+
+  private:
+    DetectorConstruction*  fDetector;
+    WeightWindowMessenger* fMessenger;
+    G4int                  fNbCells[3];
+    G4ThreeVector          fOrigin;
+    G4ThreeVector          fCellSize;
+    G4LogicalVolume*       fCellL;
+    G4VPhysicalVolume*     fWorldP;
+    G4VPhysicalVolume*     fMeshP;
+    std::vector<const G4VPhysicalVolume*> fCell;   // [cell]
+
+    G4double               fUpperFactor;
+    G4double               fSurvivalFactor;
+    G4int                  fMaxSplits;
+    G4PlaceOfAction        fPlace;
+
+    std::vector<G4double>  fLowerWeight;           // [cell][group]
+    G4String               fGenerationFile;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
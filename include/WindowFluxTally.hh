@@ -0,0 +1,87 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file WindowFluxTally.hh
+/// \brief Definition of the WindowFluxTally class
+//
+// Neutron track length in each cell of the weight-window mesh and energy
+// group, scored during a pilot run (WeightWindowSD) and turned into
+// weight windows by WeightWindowWorld::GenerateWindows at end of run.
+// Energy groups: < 1 eV, 1 eV - 100 keV, > 100 keV.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef WindowFluxTally_h
+#define WindowFluxTally_h 1
+
+#include "globals.hh"
+#include "G4SystemOfUnits.hh"
+#include <cfloat>
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class WindowFluxTally
+{
+  public:
+    enum { kNbGroups = 3 };
+
+    WindowFluxTally() : fNbCells(0) { };
+   ~WindowFluxTally() { };
+
+    static G4int GetGroup(G4double energy)
+      { return (energy < 1*eV) ? 0 : (energy < 100*keV) ? 1 : 2; };
+    // upper energy bound of a group (the last one is unbounded)
+    static G4double GetGroupBound(G4int group)
+      { return (group == 0) ? 1*eV : (group == 1) ? 100*keV : DBL_MAX; };
+
+    // clears the sums (begin of run)
+    void Book(G4int nbCells)
+      { fNbCells = nbCells; fFlux.assign(nbCells*kNbGroups, 0.); };
+    G4bool IsBooked() const              { return fNbCells > 0; };
+    G4int  GetNbCells() const            { return fNbCells; };
+
+    void Score(G4int cell, G4double energy, G4double weightedLength)
+      { fFlux[cell*kNbGroups + GetGroup(energy)] += weightedLength; };
+
+    void Merge(const WindowFluxTally& other)
+    {
+      if (other.fFlux.size() != fFlux.size()) return;
+      for (size_t i=0; i<fFlux.size(); ++i) fFlux[i] += other.fFlux[i];
+    };
+
+    G4double GetFlux(G4int cell, G4int group) const
+      { return fFlux[cell*kNbGroups + group]; };
+
+  private:
+    G4int                 fNbCells;
+    std::vector<G4double> fFlux;          // [cell][group]
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,74 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file WorkerThreadInitialization.hh
+/// \brief Definition of the WorkerThreadInitialization class
+//
+// Set on the MT run manager by Monitor; -pin gives the policy, none by
+// default, the threads then being neither pinned nor merged per node (the
+// merges are still timed, NodeWorkerRunManager). Each worker thread pins
+// itself (ThreadAffinity) when it creates its run manager, before its
+// user actions are built: the buffers of the thread (tallies of its Run,
+// crossing and phase-space blocks, HistoManager, allocator pages) are then
+// first touched, and allocated, on its own NUMA node. Its run manager
+// merges through the node (NodeWorkerRunManager).
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef WorkerThreadInitialization_h
+#define WorkerThreadInitialization_h 1
+
+#include "G4Types.hh"
+
+#ifdef G4MULTITHREADED
+
+#include "G4UserWorkerThreadInitialization.hh"
+#include "globals.hh"
+
+class ThreadAffinity;
+class NodeMerger;
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class WorkerThreadInitialization : public G4UserWorkerThreadInitialization
+{
+  public:
+    WorkerThreadInitialization(const G4String& policy, G4int nbThreads);
+    virtual ~WorkerThreadInitialization();
+
+    // worker thread: pin, then the run manager of the thread
+    virtual G4WorkerRunManager* CreateWorkerRunManager() const;
+
+  private:
+    ThreadAffinity* fAffinity;
+    NodeMerger*     fMerger;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
+#endif
@@ -35,12 +35,18 @@
 #include "SteppingAction.hh"
 #include "SteppingVerbose.hh"
 #include "StackingAction.hh"
+#include "HistoManager.hh"
+#include "AdjointRunAction.hh"
+#include "AdjointEventAction.hh"
+
+#include "G4AdjointSimManager.hh"
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-ActionInitialization::ActionInitialization(DetectorConstruction* detector)
+ActionInitialization::ActionInitialization(DetectorConstruction* detector,
+                                           G4bool adjoint)
  : G4VUserActionInitialization(),
-   fDetector(detector)
+   fDetector(detector), fAdjoint(adjoint)
 {}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -74,9 +80,21 @@ void ActionInitialization::Build() const
   
   SteppingAction* steppingAction = new SteppingAction(eventAction, trackingAction);
   SetUserAction(steppingAction);
+  runAction->SetSteppingAction(steppingAction);
   
   StackingAction* stackingAction = new StackingAction();
   SetUserAction(stackingAction);    
+  runAction->SetStackingAction(stackingAction);
+
+  // reverse Monte Carlo mode: G4AdjointSimManager swaps these in for
+  // the adjoint events of /adjoint/start_run
+  if (fAdjoint) {
+    AdjointRunAction* adjointRun
+      = new AdjointRunAction(runAction->GetHistoManager()->GetDoseConversion());
+    G4AdjointSimManager* adjointManager = G4AdjointSimManager::GetInstance();
+    adjointManager->SetAdjointRunAction(adjointRun);
+    adjointManager->SetAdjointEventAction(new AdjointEventAction(adjointRun));
+  }
 }  
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
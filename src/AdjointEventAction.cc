@@ -0,0 +1,74 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file AdjointEventAction.cc
+/// \brief Implementation of the AdjointEventAction class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "AdjointEventAction.hh"
+#include "AdjointRunAction.hh"
+
+#include "G4AdjointSimManager.hh"
+#include "G4Event.hh"
+#include "G4PrimaryParticle.hh"
+#include "G4PrimaryVertex.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+AdjointEventAction::AdjointEventAction(AdjointRunAction* run)
+  : G4UserEventAction(), fRunAction(run)
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+AdjointEventAction::~AdjointEventAction()
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AdjointEventAction::EndOfEventAction(const G4Event* evt)
+{
+  G4AdjointSimManager* manager = G4AdjointSimManager::GetInstance();
+  if (!manager->GetAdjointSimMode() || !evt->GetPrimaryVertex()) return;
+
+  // energy of the adjoint primary, sampled on the receptor
+  G4double receptorEnergy
+    = evt->GetPrimaryVertex()->GetPrimary()->GetKineticEnergy();
+
+  size_t nbTracks = manager->GetNbOfAdointTracksReachingTheExternalSurface();
+  for (size_t i=0; i<nbTracks; ++i) {
+    if (manager->GetFwdParticlePDGEncodingAtEndOfLastAdjointTrack(i) != 22) continue;
+    fRunAction->Score(manager->GetEkinAtEndOfLastAdjointTrack(i), receptorEnergy,
+                      manager->GetWeightAtEndOfLastAdjointTrack(i));
+  }
+  manager->ClearEndOfAdjointTrackInfoVectors();
+  fRunAction->EndOfEvent();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
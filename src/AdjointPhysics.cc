@@ -0,0 +1,116 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file AdjointPhysics.cc
+/// \brief Implementation of the AdjointPhysics class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "AdjointPhysics.hh"
+
+#include "G4AdjointCSManager.hh"
+#include "G4AdjointComptonModel.hh"
+#include "G4AdjointGamma.hh"
+#include "G4AdjointProcessEquivalentToDirectProcess.hh"
+#include "G4EmParameters.hh"
+#include "G4EmProcessSubType.hh"
+#include "G4eInverseCompton.hh"
+#include "G4Gamma.hh"
+#include "G4ProcessManager.hh"
+#include "G4ProcessVector.hh"
+#include "G4VEmProcess.hh"
+#include "G4Version.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+AdjointPhysics::AdjointPhysics()
+  : G4VPhysicsConstructor("AdjointGamma")
+{
+  // the absorption needs the separate gamma processes
+#if G4VERSION_NUMBER >= 1050
+  G4EmParameters::Instance()->SetGeneralProcessActive(false);
+#endif
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+AdjointPhysics::~AdjointPhysics()
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AdjointPhysics::ConstructParticle()
+{
+  G4AdjointGamma::AdjointGamma();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AdjointPhysics::ConstructProcess()
+{
+  G4AdjointCSManager* csManager = G4AdjointCSManager::GetAdjointCSManager();
+  G4ParticleDefinition* gamma = G4Gamma::Gamma();
+  G4ParticleDefinition* adjointGamma = G4AdjointGamma::AdjointGamma();
+  csManager->RegisterAdjointParticle(adjointGamma);
+
+  // forward gamma interactions: total cross sections for the manager,
+  // absorption of the adjoint gammas
+  G4ProcessManager* adjointManager = adjointGamma->GetProcessManager();
+  G4ProcessVector* processes = gamma->GetProcessManager()->GetProcessList();
+  G4bool photoElectric = false, conversion = false;
+  for (G4int i=0; i<G4int(processes->size()); ++i) {
+    G4VEmProcess* process = dynamic_cast<G4VEmProcess*>((*processes)[i]);
+    if (!process) continue;
+    csManager->RegisterEmProcess(process, gamma);
+    G4int subType = process->GetProcessSubType();
+    if (subType == fPhotoElectricEffect || subType == fGammaConversion) {
+      adjointManager->AddDiscreteProcess(
+        new G4AdjointProcessEquivalentToDirectProcess("Adj_" + process->GetProcessName(),
+                                                      process, gamma));
+      if (subType == fPhotoElectricEffect) photoElectric = true;
+      else                                 conversion = true;
+    }
+  }
+  if (!photoElectric || !conversion) {
+    G4ExceptionDescription description;
+    description << "no separate gamma "
+                << (photoElectric ? "conversion" : "photoelectric")
+                << " process: the adjoint gammas would not be absorbed";
+    G4Exception("AdjointPhysics::ConstructProcess", "Adjoint001",
+                FatalException, description);
+  }
+
+  // scattering: the adjoint gamma gains the energy lost by the forward
+  // gamma; the Compton electron is not followed
+  G4AdjointComptonModel* compton = new G4AdjointComptonModel();
+  compton->SetSecondPartOfSameType(false);
+  compton->SetUseMatrix(false);
+  adjointManager->AddDiscreteProcess(new G4eInverseCompton(true, "Inv_Compt", compton));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
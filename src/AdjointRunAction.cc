@@ -0,0 +1,163 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file AdjointRunAction.cc
+/// \brief Implementation of the AdjointRunAction class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "AdjointRunAction.hh"
+#include "CrossingBuffer.hh"
+#include "FluenceToDose.hh"
+#include "HistoManager.hh"
+
+#include "G4Run.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4UnitsTable.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+AdjointRunAction::AdjointRunAction(const FluenceToDose* dose)
+  : G4UserRunAction(), fDose(dose),
+    fLogEmin(std::log(10.*keV)), fLogEmax(std::log(20.*MeV)), fNbBins(40),
+    fEventScored(false)
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+AdjointRunAction::~AdjointRunAction()
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AdjointRunAction::BeginOfRunAction(const G4Run*)
+{
+  fEventSum.assign(fNbBins, 0.);
+  fSum1.assign(fNbBins, 0.);
+  fSum2.assign(fNbBins, 0.);
+  fEventScored = false;
+  fTimer.Start();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline G4int AdjointRunAction::GetBin(G4double energy) const
+{
+  G4int bin = G4int((std::log(energy) - fLogEmin)/(fLogEmax - fLogEmin)*fNbBins);
+  return std::min(std::max(bin, 0), fNbBins-1);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double AdjointRunAction::GetLowEdge(G4int bin) const
+{
+  return std::exp(fLogEmin + bin*(fLogEmax - fLogEmin)/fNbBins);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AdjointRunAction::Score(G4double sourceEnergy, G4double receptorEnergy,
+                             G4double weight)
+{
+  fEventSum[GetBin(sourceEnergy)]
+    += weight*fDose->GetCoefficient(CrossingRecord::kGamma, receptorEnergy);
+  fEventScored = true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AdjointRunAction::EndOfEvent()
+{
+  if (!fEventScored) return;
+  for (G4int b=0; b<fNbBins; ++b) {
+    G4double x = fEventSum[b];
+    if (x == 0.) continue;
+    fSum1[b] += x;
+    fSum2[b] += x*x;
+    fEventSum[b] = 0.;
+  }
+  fEventScored = false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AdjointRunAction::EndOfRunAction(const G4Run* run)
+{
+  fTimer.Stop();
+  G4int nbEvents = run->GetNumberOfEvent();
+  if (nbEvents == 0) return;
+
+  // R^2 = sum x^2/(sum x)^2 - 1/N for the per-event responses x of a bin
+  G4int dfprec = G4cout.precision(4);
+  G4cout << "\n Adjoint gamma dose response of the receptor (pSv cm2), per"
+         << " source energy (" << nbEvents << " adjoint events in "
+         << fTimer.GetRealElapsed() << " s)" << G4endl;
+  for (G4int b=0; b<fNbBins; ++b) {
+    if (fSum1[b] <= 0.) continue;
+    G4double r2 = std::max(fSum2[b]/(fSum1[b]*fSum1[b]) - 1./nbEvents, 0.);
+    G4cout << "  " << std::setw(10) << G4BestUnit(GetLowEdge(b),"Energy")
+           << " - " << std::setw(10) << G4BestUnit(GetLowEdge(b+1),"Energy")
+           << ": " << std::setw(10) << fSum1[b]/nbEvents
+           << "  R = " << std::sqrt(r2) << G4endl;
+  }
+  G4cout.precision(dfprec);
+
+  Write(G4AnalysisManager::Instance()->GetFileName() + "_adjoint.csv", nbEvents);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void AdjointRunAction::Write(const G4String& fileName, G4int nbEvents) const
+{
+  std::ofstream file(fileName);
+  if (!file) {
+    G4cout << "\n--> warning from AdjointRunAction::Write : "
+           << "cannot open " << fileName << G4endl;
+    return;
+  }
+  file << "# adjoint gamma dose response of the receptor, " << nbEvents
+       << " events\n";
+  file << "# Elow[MeV],Ehigh[MeV],response[pSv cm2],relError\n";
+  file.precision(6);
+  for (G4int b=0; b<fNbBins; ++b) {
+    G4double r = 0.;
+    if (fSum1[b] > 0.) {
+      r = std::sqrt(std::max(fSum2[b]/(fSum1[b]*fSum1[b]) - 1./nbEvents, 0.));
+    }
+    file << GetLowEdge(b)/MeV << "," << GetLowEdge(b+1)/MeV << ","
+         << fSum1[b]/nbEvents << "," << r << "\n";
+  }
+  G4cout << "\n Adjoint responses written to " << fileName << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
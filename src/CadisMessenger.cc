@@ -0,0 +1,145 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file CadisMessenger.cc
+/// \brief Implementation of the CadisMessenger class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "CadisMessenger.hh"
+
+#include "CadisTool.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWith3VectorAndUnit.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CadisMessenger::CadisMessenger(CadisTool* tool)
+:G4UImessenger(), fTool(tool),
+ fCadisDir(0), fTargetCmd(0), fClearCmd(0), fSourceCmd(0), fBinsCmd(0),
+ fRunCmd(0)
+{
+  // the tool works on the master geometry and writes files: master only
+  G4bool broadcast = false;
+  fCadisDir = new G4UIdirectory("/testhadr/bias/cadis/",broadcast);
+  fCadisDir->SetGuidance("weight windows and source biasing from an");
+  fCadisDir->SetGuidance("estimate of the adjoint flux of target points");
+
+  fTargetCmd = new G4UIcmdWith3VectorAndUnit("/testhadr/bias/cadis/addTarget",this);
+  fTargetCmd->SetGuidance("Add a target point of the tally (dose point)");
+  fTargetCmd->SetParameterName("x","y","z",false);
+  fTargetCmd->SetUnitCategory("Length");
+  fTargetCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fClearCmd = new G4UIcmdWithoutParameter("/testhadr/bias/cadis/clearTargets",this);
+  fClearCmd->SetGuidance("Remove all the target points");
+  fClearCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fSourceCmd = new G4UIcmdWith3VectorAndUnit("/testhadr/bias/cadis/source",this);
+  fSourceCmd->SetGuidance("Position of the point source (default 0 0 -80 cm)");
+  fSourceCmd->SetParameterName("x","y","z",false);
+  fSourceCmd->SetUnitCategory("Length");
+  fSourceCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fBinsCmd = new G4UIcommand("/testhadr/bias/cadis/angularBins",this);
+  fBinsCmd->SetGuidance("Bins of the angular source biasing:");
+  fBinsCmd->SetGuidance("nb of bins in cos(theta) and in phi (default 18 36)");
+  //
+  G4UIparameter* cosPrm = new G4UIparameter("nbCos",'i',false);
+  cosPrm->SetParameterRange("nbCos>0");
+  fBinsCmd->SetParameter(cosPrm);
+  //
+  G4UIparameter* phiPrm = new G4UIparameter("nbPhi",'i',false);
+  phiPrm->SetParameterRange("nbPhi>0");
+  fBinsCmd->SetParameter(phiPrm);
+  //
+  fBinsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fRunCmd = new G4UIcommand("/testhadr/bias/cadis/run",this);
+  fRunCmd->SetGuidance("Compute the importance map of the target points and");
+  fRunCmd->SetGuidance("write the weight windows of the /testhadr/bias/ww mesh");
+  fRunCmd->SetGuidance("and the angular source biasing, for a production run.");
+  //
+  G4UIparameter* wwPrm = new G4UIparameter("windowFile",'s',false);
+  wwPrm->SetGuidance("file for /testhadr/bias/ww/load");
+  fRunCmd->SetParameter(wwPrm);
+  //
+  G4UIparameter* srcPrm = new G4UIparameter("sourceFile",'s',false);
+  srcPrm->SetGuidance("file for /testhadr/gun/angularBias");
+  fRunCmd->SetParameter(srcPrm);
+  //
+  fRunCmd->AvailableForStates(G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CadisMessenger::~CadisMessenger()
+{
+  delete fTargetCmd;
+  delete fClearCmd;
+  delete fSourceCmd;
+  delete fBinsCmd;
+  delete fRunCmd;
+  delete fCadisDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CadisMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fTargetCmd)
+   { fTool->AddTarget(fTargetCmd->GetNew3VectorValue(newValue)); }
+
+  if (command == fClearCmd)
+   { fTool->ClearTargets(); }
+
+  if (command == fSourceCmd)
+   { fTool->SetSource(fSourceCmd->GetNew3VectorValue(newValue)); }
+
+  if (command == fBinsCmd)
+   {
+     G4int nbCos, nbPhi;
+     std::istringstream is(newValue);
+     is >> nbCos >> nbPhi;
+     fTool->SetAngularBins(nbCos, nbPhi);
+   }
+
+  if (command == fRunCmd)
+   {
+     G4String windowFile, sourceFile;
+     std::istringstream is(newValue);
+     is >> windowFile >> sourceFile;
+     fTool->Run(windowFile, sourceFile);
+   }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
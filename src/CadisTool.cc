@@ -0,0 +1,285 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file CadisTool.cc
+/// \brief Implementation of the CadisTool class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "CadisTool.hh"
+#include "CadisMessenger.hh"
+#include "DetectorConstruction.hh"
+#include "WeightWindowWorld.hh"
+#include "WindowFluxTally.hh"
+
+#include "G4Material.hh"
+#include "G4Navigator.hh"
+#include "G4LogicalVolume.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4UnitsTable.hh"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <fstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CadisTool::CadisTool(DetectorConstruction* det)
+  : fDetector(det), fMessenger(0), fNavigator(0),
+    fSource(0., 0., -0.8*m), fNbCos(18), fNbPhi(36)
+{
+  fMessenger = new CadisMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CadisTool::~CadisTool()
+{
+  delete fNavigator;
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double CadisTool::GetRemovalCrossSection(const G4Material* material)
+{
+  std::map<const G4Material*, G4double>::const_iterator it = fRemoval.find(material);
+  if (it != fRemoval.end()) return it->second;
+
+  // mass removal cross sections of the elements [cm2/g]:
+  // 0.598 for hydrogen, 0.19 Z^-0.743 up to oxygen, 0.125 Z^-0.565 above
+  const G4ElementVector* elements = material->GetElementVector();
+  const G4double* fraction = material->GetFractionVector();
+  G4double massRemoval = 0.;
+  for (size_t i=0; i<material->GetNumberOfElements(); ++i) {
+    G4double Z = (*elements)[i]->GetZ();
+    G4double sigma;
+    if      (Z < 1.5) sigma = 0.598;
+    else if (Z < 8.5) sigma = 0.19*std::pow(Z, -0.743);
+    else              sigma = 0.125*std::pow(Z, -0.565);
+    massRemoval += fraction[i]*sigma;
+  }
+  G4double removal = massRemoval*(material->GetDensity()/(g/cm3))/cm;
+  fRemoval[material] = removal;
+  return removal;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double CadisTool::OpticalThickness(const G4ThreeVector& from,
+                                     const G4ThreeVector& to)
+{
+  G4ThreeVector direction = to - from;
+  G4double length = direction.mag();
+  if (length <= 0.) return 0.;
+  direction /= length;
+
+  // step from boundary to boundary of the mass geometry
+  G4double tau = 0., travelled = 0., safety;
+  G4VPhysicalVolume* volume
+    = fNavigator->LocateGlobalPointAndSetup(from, &direction, false, false);
+  for (G4int nbSteps=0; volume && travelled < length && nbSteps < 10000; ++nbSteps) {
+    G4double step = fNavigator->ComputeStep(from + travelled*direction,
+                                            direction, length - travelled,
+                                            safety);
+    step = std::min(std::max(step, 1.e-6*mm), length - travelled);
+    tau += GetRemovalCrossSection(volume->GetLogicalVolume()->GetMaterial())*step;
+    travelled += step;
+    fNavigator->SetGeometricallyLimitedStep();
+    volume = fNavigator->LocateGlobalPointAndSetup(from + travelled*direction,
+                                                   &direction, true);
+  }
+  return tau;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double CadisTool::Adjoint(const G4ThreeVector& point, G4double minDistance)
+{
+  G4double adjoint = 0.;
+  for (size_t t=0; t<fTarget.size(); ++t) {
+    G4double distance = std::max((fTarget[t] - point).mag(), minDistance)/cm;
+    adjoint += std::exp(-OpticalThickness(point, fTarget[t]))
+              /(4*pi*distance*distance);
+  }
+  return std::max(adjoint, 1.e-300);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CadisTool::Run(const G4String& windowFile, const G4String& sourceFile)
+{
+  WeightWindowWorld* windows = fDetector->GetWeightWindowWorld();
+  if (fTarget.empty() || !windows->HasMesh()) {
+    G4cout << "\n--> warning from CadisTool::Run : "
+           << "needs a target (/testhadr/bias/cadis/addTarget) and the"
+           << " weight-window mesh (/testhadr/bias/ww/setMesh)" << G4endl;
+    return;
+  }
+  if (!fNavigator) fNavigator = new G4Navigator();
+  fNavigator->SetWorldVolume(fDetector->worldP);
+
+  // mesh of the windows, holding the source
+  G4ThreeVector origin = windows->GetMeshOrigin();
+  G4ThreeVector size   = windows->GetCellSize();
+  if (size.mag() <= 0.) {
+    G4cout << "\n--> warning from CadisTool::Run : "
+           << "the geometry is not built yet (/run/initialize)" << G4endl;
+    return;
+  }
+  G4int nbCells[3] = { windows->GetNbCells(0), windows->GetNbCells(1),
+                       windows->GetNbCells(2) };
+  G4int sourceCell[3];
+  for (G4int i=0; i<3; ++i) {
+    sourceCell[i] = (G4int)std::floor((fSource[i] - origin[i])/size[i]);
+    if (sourceCell[i] < 0 || sourceCell[i] >= nbCells[i]) {
+      G4cout << "\n--> warning from CadisTool::Run : "
+             << "the source must be inside the weight-window mesh" << G4endl;
+      return;
+    }
+  }
+
+  // adjoint flux at the cell centres
+  G4int nx = nbCells[0], ny = nbCells[1], nz = nbCells[2];
+  G4double minDistance = 0.5*size.mag();
+  std::vector<G4double> adjoint(nx*ny*nz);
+  for (G4int ix=0; ix<nx; ++ix) {
+    for (G4int iy=0; iy<ny; ++iy) {
+      for (G4int iz=0; iz<nz; ++iz) {
+        G4ThreeVector center = origin + G4ThreeVector((ix+0.5)*size.x(),
+                                                      (iy+0.5)*size.y(),
+                                                      (iz+0.5)*size.z());
+        adjoint[(ix*ny + iy)*nz + iz] = Adjoint(center, minDistance);
+      }
+    }
+  }
+
+  // importance of the directions of emission: the adjoint flux of the
+  // cell entered on leaving the source cell, whose window is the first
+  // one met
+  G4ThreeVector cellLow = origin + G4ThreeVector(sourceCell[0]*size.x(),
+                                                 sourceCell[1]*size.y(),
+                                                 sourceCell[2]*size.z());
+  G4ThreeVector cellHigh = cellLow + size;
+  std::vector<G4double> importance(fNbCos*fNbPhi);
+  G4double sum = 0.;
+  for (G4int ic=0; ic<fNbCos; ++ic) {
+    G4double cosTheta = -1. + (ic+0.5)*2./fNbCos;
+    G4double sinTheta = std::sqrt(1. - cosTheta*cosTheta);
+    for (G4int ip=0; ip<fNbPhi; ++ip) {
+      G4double phi = (ip+0.5)*twopi/fNbPhi;
+      G4ThreeVector u(sinTheta*std::cos(phi), sinTheta*std::sin(phi), cosTheta);
+      G4double exit = DBL_MAX;
+      for (G4int i=0; i<3; ++i) {
+        if (u[i] > 0.) exit = std::min(exit, (cellHigh[i] - fSource[i])/u[i]);
+        if (u[i] < 0.) exit = std::min(exit, (cellLow[i]  - fSource[i])/u[i]);
+      }
+      // outside the mesh: the nearest cell
+      G4ThreeVector point = fSource + (exit + 1*um)*u;
+      G4int index[3];
+      for (G4int i=0; i<3; ++i) {
+        index[i] = (G4int)std::floor((point[i] - origin[i])/size[i]);
+        index[i] = std::min(std::max(index[i], 0), nbCells[i] - 1);
+      }
+      G4double value = adjoint[(index[0]*ny + index[1])*nz + index[2]];
+      importance[ic*fNbPhi + ip] = value;
+      sum += value;
+    }
+  }
+
+  // R: the importance averaged over the isotropic source. The biased pdf
+  // is importance/R times the isotropic one, so a primary is born with
+  // the weight R/importance: the centre of the first window it meets
+  G4int nbBins = fNbCos*fNbPhi;
+  G4double response = sum/nbBins;
+  std::vector<G4double> probability(nbBins);
+  for (G4int b=0; b<nbBins; ++b) probability[b] = importance[b]/sum;
+
+  const G4int nbGroups = WindowFluxTally::kNbGroups;
+  std::vector<G4double> lowerWeight(nx*ny*nz*nbGroups);
+  G4double wlMin = DBL_MAX, wlMax = 0.;
+  for (G4int cell=0; cell<nx*ny*nz; ++cell) {
+    G4double wl = response/adjoint[cell]/windows->GetSurvivalFactor();
+    for (G4int g=0; g<nbGroups; ++g) lowerWeight[cell*nbGroups + g] = wl;
+    wlMin = std::min(wlMin, wl);
+    wlMax = std::max(wlMax, wl);
+  }
+
+  G4bool done = windows->WriteWindows(windowFile, lowerWeight);
+  done = WriteSourceBias(sourceFile, probability) && done;
+
+  G4int dfprec = G4cout.precision(4);
+  G4cout << "\n CADIS importance map for " << fTarget.size() << " target point(s),"
+         << " source at " << G4BestUnit(fSource,"Length")
+         << "\n   response R = " << response << " /cm2"
+         << "\n   lower weights of the " << nx*ny*nz << " cells: "
+         << wlMin << " to " << wlMax
+         << "\n   largest angular source weight: "
+         << (1./nbBins)/(*std::min_element(probability.begin(), probability.end()))
+         << ", smallest: "
+         << (1./nbBins)/(*std::max_element(probability.begin(), probability.end()));
+  if (done) {
+    G4cout << "\n   written to " << windowFile << " (/testhadr/bias/ww/load)"
+           << " and " << sourceFile << " (/testhadr/gun/angularBias)";
+  }
+  G4cout << G4endl;
+  G4cout.precision(dfprec);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool CadisTool::WriteSourceBias(const G4String& fileName,
+                                  const std::vector<G4double>& probability) const
+{
+  std::ofstream file(fileName);
+  if (!file) {
+    G4cout << "\n--> warning from CadisTool::WriteSourceBias : "
+           << "cannot open " << fileName << G4endl;
+    return false;
+  }
+
+  // bins of equal solid angle: uniform in cos(theta) and phi
+  G4int nbBins = fNbCos*fNbPhi;
+  file << "# angular source bias of an isotropic point source\n";
+  file << "# source [cm]: " << fSource.x()/cm << " " << fSource.y()/cm
+       << " " << fSource.z()/cm << "\n";
+  file << "# bins: " << fNbCos << " " << fNbPhi << "\n";
+  file << "# iCos,iPhi,probability,weight\n";
+  file.precision(6);
+  for (G4int ic=0; ic<fNbCos; ++ic) {
+    for (G4int ip=0; ip<fNbPhi; ++ip) {
+      G4double p = probability[ic*fNbPhi + ip];
+      file << ic << "," << ip << "," << p << "," << (1./nbBins)/p << "\n";
+    }
+  }
+  return file.good();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,154 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file CaptureBiasingOperator.cc
+/// \brief Implementation of the CaptureBiasingOperator class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "CaptureBiasingOperator.hh"
+#include "NeutronHPphysics.hh"
+
+#include "G4BiasingProcessInterface.hh"
+#include "G4BOptnChangeCrossSection.hh"
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4Neutron.hh"
+#include "G4Track.hh"
+#include "G4Threading.hh"
+#include "Randomize.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CaptureBiasingOperator::CaptureBiasingOperator(const NeutronHPphysics* physics)
+  : G4VBiasingOperator("CaptureBiasingOperator"), fPhysics(physics),
+    fOperation(0)
+{
+  fOperation = new G4BOptnChangeCrossSection("XSchange-nCapture");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CaptureBiasingOperator::~CaptureBiasingOperator()
+{
+  delete fOperation;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CaptureBiasingOperator::StartRun()
+{
+  // (re)attach to the volumes of the current geometry
+  fFactor.clear();
+  const G4LogicalVolumeStore* store = G4LogicalVolumeStore::GetInstance();
+  for (size_t i=0; i<store->size(); ++i) {
+    const G4LogicalVolume* volume = (*store)[i];
+    G4double factor = fPhysics->GetCaptureFactor(volume);
+    if (factor == 1.) continue;
+    fFactor[volume] = factor;
+    if (GetBiasingOperator(volume) != this) AttachTo(volume);
+  }
+
+  if (!G4Threading::IsMasterThread()) return;
+  G4cout << "\n Neutron capture biasing:";
+  std::map<const G4LogicalVolume*, G4double>::const_iterator it;
+  for (it = fFactor.begin(); it != fFactor.end(); ++it) {
+    G4cout << "  " << it->first->GetName();
+    if (it->second == 0.) G4cout << " (implicit)";
+    else                  G4cout << " x" << it->second;
+  }
+  G4cout << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4VBiasingOperation* CaptureBiasingOperator::ProposeOccurenceBiasingOperation(
+                                 const G4Track* track,
+                                 const G4BiasingProcessInterface* callingProcess)
+{
+  if (track->GetDefinition() != G4Neutron::Definition()) return 0;
+
+  std::map<const G4LogicalVolume*, G4double>::const_iterator it
+    = fFactor.find(track->GetVolume()->GetLogicalVolume());
+  if (it == fFactor.end()) return 0;
+
+  G4double analogLength
+    = callingProcess->GetWrappedProcess()->GetCurrentInteractionLength();
+  if (analogLength > DBL_MAX/10.) return 0;
+  G4double biasedXS = it->second/analogLength;
+
+  // a new interaction length after an interaction, else the remaining one
+  // is carried over with the cross section of the new step
+  G4VBiasingOperation* previous
+    = callingProcess->GetPreviousOccurenceBiasingOperation();
+  if (previous != fOperation || fOperation->GetInteractionOccured()) {
+    fOperation->SetBiasedCrossSection(biasedXS);
+    fOperation->Sample();
+  } else {
+    fOperation->UpdateForStep(callingProcess->GetPreviousStepSize());
+    fOperation->SetBiasedCrossSection(biasedXS);
+    fOperation->UpdateForStep(0.);
+  }
+  return fOperation;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CaptureBiasingOperator::OperationApplied(const G4BiasingProcessInterface*,
+                                 G4BiasingAppliedCase,
+                                 G4VBiasingOperation* occurenceOperationApplied,
+                                 G4double,
+                                 G4VBiasingOperation*,
+                                 const G4VParticleChange*)
+{
+  if (occurenceOperationApplied == fOperation) fOperation->SetInteractionOccured();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool CaptureBiasingOperator::HasImplicitCapture(const G4LogicalVolume* volume) const
+{
+  std::map<const G4LogicalVolume*, G4double>::const_iterator it
+    = fFactor.find(volume);
+  return (it != fFactor.end() && it->second == 0.);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CaptureBiasingOperator::PlayRoulette(G4Track* track) const
+{
+  G4double weight = track->GetWeight();
+  if (weight >= fPhysics->GetWeightCutoff()) return;
+
+  // survive with probability weight/survivalWeight
+  G4double survival = fPhysics->GetSurvivalWeight();
+  if (G4UniformRand()*survival < weight) track->SetWeight(survival);
+  else                                    track->SetTrackStatus(fStopAndKill);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,253 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file ChunkedRunManager.cc
+/// \brief Implementation of the ChunkedRunManager class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "ChunkedRunManager.hh"
+
+#ifdef G4MULTITHREADED
+
+#include "G4Threading.hh"
+#include "G4RNGHelper.hh"
+#include "G4Event.hh"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace {
+  const G4double kSmoothing = 0.5;   // weight of the last chunk in the cost
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ChunkedRunManager::ChunkedRunManager()
+  : G4MTRunManager(), fAdaptive(true), fMinChunk(1), fDivisor(2), fRunID(0)
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ChunkedRunManager::~ChunkedRunManager()
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ChunkedRunManager::RunInitialization()
+{
+  // the costs of the previous run are kept as first guesses
+  {
+    std::lock_guard<std::mutex> lock(fMutex);
+    ++fRunID;
+    fRunStart = Clock::now();
+  }
+  G4MTRunManager::RunInitialization();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ChunkedRunManager::WorkerLoad& ChunkedRunManager::EndChunk()
+{
+  size_t id = std::max(G4Threading::G4GetThreadId(), 0);
+  if (id >= fLoads.size()) fLoads.resize(id+1);
+  WorkerLoad& load = fLoads[id];
+
+  // the worker has processed the chunk of its previous request
+  Clock::time_point now = Clock::now();
+  if (load.runID != fRunID) {
+    load.runID  = fRunID;
+    load.busy   = 0.;
+    load.total  = 0;
+    load.start  = std::chrono::duration<G4double>(now - fRunStart).count();
+    load.merge  = 0.;
+    load.merged = 0.;
+  }
+  else if (load.nbEvents > 0) {
+    G4double elapsed = std::chrono::duration<G4double>(now - load.last).count();
+    G4double cost = elapsed/load.nbEvents;
+    load.cost  = (load.cost > 0.) ? kSmoothing*cost + (1.-kSmoothing)*load.cost
+                                  : cost;
+    load.busy += elapsed;
+  }
+  load.last = now;
+  load.done = std::chrono::duration<G4double>(now - fRunStart).count();
+  load.nbEvents = 0;
+  return load;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int ChunkedRunManager::GetChunkSize(const WorkerLoad& load, G4int maxChunk) const
+{
+  G4int remaining = numberOfEventToBeProcessed - numberOfEventProcessed;
+  G4int threads   = std::max(nworkers, 1);
+
+  // equal costs: a share of the events left
+  G4double chunk = G4double(remaining)/(fDivisor*threads);
+
+  // measured costs: a share of the time left, the threads not measured
+  // yet being given the mean rate of the others
+  G4double rate = 0.;
+  G4int nbMeasured = 0;
+  for (size_t i=0; i<fLoads.size(); ++i) {
+    if (fLoads[i].cost > 0.) { rate += 1./fLoads[i].cost; ++nbMeasured; }
+  }
+  if (load.cost > 0. && nbMeasured > 0) {
+    rate *= G4double(std::max(threads, nbMeasured))/nbMeasured;
+    G4double timeLeft = remaining/rate;
+    chunk = timeLeft/(fDivisor*load.cost);
+  }
+
+  G4int minChunk = std::min(fMinChunk, maxChunk);
+  if (chunk >= maxChunk) return maxChunk;
+  return std::max(G4int(chunk), minChunk);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+size_t ChunkedRunManager::SetUpNEvents(G4Event* event, G4SeedsQueue* seeds,
+                                       G4bool reseedRequired)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  WorkerLoad& load = EndChunk();
+
+  // as G4MTRunManager, with a chunk of our own: the event modulo, read by
+  // the workers without this lock, is left alone
+  G4int nbEvents = 0;
+  if (numberOfEventProcessed < numberOfEventToBeProcessed) {
+    nbEvents = fAdaptive ? GetChunkSize(load, eventModulo) : eventModulo;
+    nbEvents = std::min(nbEvents,
+                        numberOfEventToBeProcessed - numberOfEventProcessed);
+    event->SetEventID(numberOfEventProcessed);
+    if (reseedRequired) {
+      G4RNGHelper* helper = G4RNGHelper::GetInstance();
+      G4int nbSeeded = (SeedOncePerCommunication() > 0) ? 1 : nbEvents;
+      for (G4int i=0; i<nbSeeded; ++i) {
+        for (G4int k=0; k<nSeedsPerEvent; ++k) {
+          seeds->push(helper->GetSeed(nSeedsPerEvent*nSeedsUsed + k));
+        }
+        if (++nSeedsUsed == nSeedsFilled) RefillSeeds();
+      }
+    }
+    numberOfEventProcessed += nbEvents;
+  }
+
+  load.nbEvents = nbEvents;
+  load.total   += nbEvents;
+  return nbEvents;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool ChunkedRunManager::SetUpAnEvent(G4Event* event, long& s1, long& s2,
+                                       long& s3, G4bool reseedRequired)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  WorkerLoad& load = EndChunk();
+  G4bool more = G4MTRunManager::SetUpAnEvent(event, s1, s2, s3, reseedRequired);
+  load.nbEvents = more ? 1 : 0;
+  load.total   += load.nbEvents;
+  return more;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ChunkedRunManager::BeginMerge()
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  size_t id = std::max(G4Threading::G4GetThreadId(), 0);
+  if (id >= fLoads.size() || fLoads[id].runID != fRunID) return;
+  fLoads[id].merged = std::chrono::duration<G4double>(Clock::now()
+                                                      - fRunStart).count();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ChunkedRunManager::EndMerge()
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  size_t id = std::max(G4Threading::G4GetThreadId(), 0);
+  if (id >= fLoads.size() || fLoads[id].runID != fRunID) return;
+  WorkerLoad& load = fLoads[id];
+  G4double now = std::chrono::duration<G4double>(Clock::now()
+                                                 - fRunStart).count();
+  load.merge  = now - load.merged;
+  load.merged = now;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ChunkedRunManager::RunTermination()
+{
+  G4MTRunManager::RunTermination();
+
+  // the workers of this run asked last when they ran out of events, and
+  // merged after it
+  std::lock_guard<std::mutex> lock(fMutex);
+  G4double start = -1., first = -1., last = 0., merged = 0., merge = 0.;
+  G4int nbWorkers = 0;
+  for (size_t i=0; i<fLoads.size(); ++i) {
+    const WorkerLoad& load = fLoads[i];
+    if (load.runID != fRunID) continue;
+    if (start < 0. || load.start < start) start = load.start;
+    if (first < 0. || load.done < first) first = load.done;
+    last   = std::max(last, load.done);
+    merged = std::max(merged, load.merged);
+    merge += load.merge;
+    ++nbWorkers;
+  }
+  if (nbWorkers == 0 || last <= 0.) return;
+
+  G4cout << "\n Event loop: " << last - start << " s, merge: "
+         << std::max(merged - last, 0.) << " s after it (" << merge
+         << " s over the threads)" << G4endl;
+
+  G4cout << "\n Load balance (" << (fAdaptive ? "adaptive" : "fixed")
+         << " chunks <= " << eventModulo << " events): the " << nbWorkers
+         << " threads ran out of events between " << first << " s and "
+         << last << " s, " << std::setprecision(3)
+         << 100.*(last - first)/last << " % of the run"
+         << std::setprecision(6) << G4endl;
+
+  if (verboseLevel < 1) return;
+  G4cout << "   thread      events    busy [s]   s/event   merge [s]"
+         << std::setprecision(4) << G4endl;
+  for (size_t i=0; i<fLoads.size(); ++i) {
+    const WorkerLoad& load = fLoads[i];
+    if (load.runID != fRunID) continue;
+    G4cout << std::setw(9) << i << std::setw(12) << load.total
+           << std::setw(12) << load.busy << std::setw(12) << load.cost
+           << std::setw(12) << load.merge << G4endl;
+  }
+  G4cout << std::setprecision(6);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,238 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file CrossingWriter.cc
+/// \brief Implementation of the CrossingWriter class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "CrossingWriter.hh"
+#include "CrossingFormat.hh"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace {
+  typedef std::chrono::steady_clock Clock;
+
+  // copy one member of the records into a column
+  template <typename T, typename F>
+  void FillColumn(char* column, const CrossingRecord* records, size_t n, F get)
+  {
+    T* out = reinterpret_cast<T*>(column);
+    for (size_t i=0; i<n; ++i) out[i] = T(get(records[i]));
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CrossingWriter* CrossingWriter::Instance()
+{
+  static CrossingWriter instance;
+  return &instance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CrossingWriter::CrossingWriter()
+  : fFullBlocks(0), fFreeBlocks(0), fBlockSize(0),
+    fStop(false), fFile(0),
+    fMaxDepth(0), fNbStalls(0), fStallTime(0),
+    fNbBlocksWritten(0), fNbRecords(0), fWriteTime(0.)
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CrossingWriter::~CrossingWriter()
+{
+  Close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CrossingWriter::Open(const G4String& fileName, size_t nbBlocks,
+                          size_t blockSize)
+{
+  if (fFile) Close();
+
+  fFile = std::fopen(fileName.c_str(), "wb");
+  if (!fFile) {
+    G4cout << "\n--> warning from CrossingWriter::Open : cannot open "
+           << fileName << G4endl;
+    return;
+  }
+  fFileName = fileName;
+  CrossingFormat::FileHeader header;
+  std::memcpy(header.magic, CrossingFormat::kMagic, sizeof(header.magic));
+  header.version   = CrossingFormat::kVersion;
+  header.nbColumns = CrossingFormat::kNbColumns;
+  std::memcpy(header.columns, CrossingFormat::kColumns, sizeof(header.columns));
+  std::fwrite(&header, sizeof(header), 1, fFile);
+  fChunk.assign(CrossingFormat::ChunkBytes(blockSize), 0);
+
+  // pool of blocks, all free at start
+  fBlockSize  = blockSize;
+  fFullBlocks = new BoundedQueue<Block*>(nbBlocks);
+  fFreeBlocks = new BoundedQueue<Block*>(nbBlocks);
+  for (size_t i=0; i<nbBlocks; ++i) {
+    Block* block = new Block;
+    block->fRecords.resize(blockSize);
+    block->fSize = 0;
+    fBlocks.push_back(block);
+    fFreeBlocks->Push(block);
+  }
+
+  fMaxDepth = 0; fNbStalls = 0; fStallTime = 0;
+  fNbBlocksWritten = 0; fNbRecords = 0; fWriteTime = 0.;
+
+  fStop = false;
+  fThread = std::thread(&CrossingWriter::WriterLoop, this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CrossingWriter::WriteCrossings(const CrossingRecord* records, size_t n)
+{
+  while (n > 0) {
+    // get a free block; wait for the writer if the pool is exhausted
+    Block* block = 0;
+    if (!fFreeBlocks->Pop(block)) {
+      Clock::time_point start = Clock::now();
+      while (!fFreeBlocks->Pop(block)) std::this_thread::yield();
+      fNbStalls++;
+      fStallTime += std::chrono::duration_cast<std::chrono::nanoseconds>
+                      (Clock::now() - start).count();
+    }
+
+    size_t nb = std::min(n, fBlockSize);
+    std::memcpy(block->fRecords.data(), records, nb*sizeof(CrossingRecord));
+    block->fSize = nb;
+    records += nb;
+    n -= nb;
+
+    // cannot fail: the queue holds as many slots as there are blocks
+    fFullBlocks->Push(block);
+    UpdateMaxDepth();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CrossingWriter::UpdateMaxDepth()
+{
+  size_t depth = fFullBlocks->GetSize();
+  size_t max = fMaxDepth.load(std::memory_order_relaxed);
+  while (depth > max &&
+         !fMaxDepth.compare_exchange_weak(max, depth,
+                                          std::memory_order_relaxed)) {}
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CrossingWriter::WriterLoop()
+{
+  Block* block = 0;
+  for (;;) {
+    if (fFullBlocks->Pop(block)) {
+      Clock::time_point start = Clock::now();
+      WriteBlock(block);
+      fWriteTime += std::chrono::duration<G4double>(Clock::now()-start).count();
+      block->fSize = 0;
+      fFreeBlocks->Push(block);
+    }
+    else if (fStop.load()) {
+      // producers are done: leave once the queue is drained
+      if (fFullBlocks->GetSize() == 0) break;
+    }
+    else {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CrossingWriter::WriteBlock(const Block* block)
+{
+  using namespace CrossingFormat;
+
+  const CrossingRecord* rec = block->fRecords.data();
+  size_t n = block->fSize;
+  char* chunk = fChunk.data();
+
+  ChunkHeader* header = reinterpret_cast<ChunkHeader*>(chunk);
+  header->magic   = kChunkMagic;
+  header->nbRows  = n;
+  header->nbBytes = ChunkBytes(n);
+
+  FillColumn<float>(chunk + ColumnOffset(kX, n), rec, n,
+                    [](const CrossingRecord& r) { return r.x; });
+  FillColumn<float>(chunk + ColumnOffset(kY, n), rec, n,
+                    [](const CrossingRecord& r) { return r.y; });
+  FillColumn<float>(chunk + ColumnOffset(kZ, n), rec, n,
+                    [](const CrossingRecord& r) { return r.z; });
+  FillColumn<float>(chunk + ColumnOffset(kEnergy, n), rec, n,
+                    [](const CrossingRecord& r) { return r.energy; });
+  FillColumn<float>(chunk + ColumnOffset(kWeight, n), rec, n,
+                    [](const CrossingRecord& r) { return r.weight; });
+  FillColumn<int32_t>(chunk + ColumnOffset(kEvent, n), rec, n,
+                    [](const CrossingRecord& r) { return r.eventID; });
+  FillColumn<uint8_t>(chunk + ColumnOffset(kParticle, n), rec, n,
+                    [](const CrossingRecord& r) { return r.particle; });
+
+  std::fwrite(chunk, 1, header->nbBytes, fFile);
+  fNbBlocksWritten++;
+  fNbRecords += block->fSize;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CrossingWriter::Close()
+{
+  if (!fFile) return;
+
+  fStop = true;
+  if (fThread.joinable()) fThread.join();
+  std::fclose(fFile);
+  fFile = 0;
+
+  G4cout << "\n Crossing records written to " << fFileName << " : "
+         << fNbRecords << " in " << fNbBlocksWritten << " blocks"
+         << "\n   writer thread busy     : " << fWriteTime << " s"
+         << "\n   max queue depth        : " << fMaxDepth.load() << " / "
+         << fFullBlocks->GetCapacity()
+         << "\n   producer stalls        : " << fNbStalls.load()
+         << " (" << 1.e-9*fStallTime.load() << " s)" << G4endl;
+
+  for (size_t i=0; i<fBlocks.size(); ++i) delete fBlocks[i];
+  fBlocks.clear();
+  delete fFullBlocks; fFullBlocks = 0;
+  delete fFreeBlocks; fFreeBlocks = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -54,13 +54,20 @@
 #include "G4UnitsTable.hh"
 #include "G4SystemOfUnits.hh"
 
+#include <algorithm>
+
 #include "HistoManager.hh"
+#include "ScoringWorld.hh"
+#include "ImportanceWorld.hh"
+#include "WeightWindowWorld.hh"
+#include "CadisTool.hh"
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 DetectorConstruction::DetectorConstruction()
 :G4VUserDetectorConstruction(),
- worldP(0), worldL(0), fMaterial(0), fDetectorMessenger(0)
+ worldP(0), worldL(0), fMaterial(0), fDetectorMessenger(0), fScoringWorld(0),
+ fImportanceWorld(0), fWeightWindowWorld(0), fCadisTool(0)
 {
   fTank_x = 7*2.5*9*cm;
   fTank_y = 9*2.5*9*cm;
@@ -80,12 +87,28 @@ DetectorConstruction::DetectorConstruction()
   DefineMaterials();
   SetMaterial("G4_AIR");   //Sets the material of the world
   fDetectorMessenger = new DetectorMessenger(this);
+
+  // voxel mesh of the dose-rate tally, in its own parallel world
+  fScoringWorld = new ScoringWorld("ScoringWorld", this);
+  RegisterParallelWorld(fScoringWorld);
+
+  // importance cells across the tank walls, in a second parallel world
+  fImportanceWorld = new ImportanceWorld("ImportanceWorld", this);
+  RegisterParallelWorld(fImportanceWorld);
+
+  // weight windows on a mesh over the room, in a third parallel world
+  fWeightWindowWorld = new WeightWindowWorld("WeightWindowWorld", this);
+  RegisterParallelWorld(fWeightWindowWorld);
+
+  // generator of its windows from the adjoint of the dose points
+  fCadisTool = new CadisTool(this);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 DetectorConstruction::~DetectorConstruction()
-{ delete fDetectorMessenger;}
+{ delete fDetectorMessenger;
+  delete fCadisTool;}
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -268,7 +291,7 @@ G4VPhysicalVolume* DetectorConstruction::ConstructVolumes()
       std::string name3 = name2.append(strj);
       G4double yTrans = -fTank_x/2 + (fTank_x/2-fChamber_x/2)/2 + i*22.5*cm; 
       G4double zTrans = -j*15*cm; 
-      G4double xTrans = -fTank_y/2+(fTank_x/2 - fChamber_x/2);
+      G4double xTrans = -fTank_x/2 + (fTank_x/2 - fChamber_x/2)/2;
       gapsP[i+j] = new G4PVPlacement(rMatrix,
 				     G4ThreeVector(xTrans, yTrans, zTrans),
 				     gapL,
@@ -332,6 +355,21 @@ void DetectorConstruction::SetSize(G4double x, G4double y, G4double z)
   G4RunManager::GetRunManager()->ReinitializeGeometry();
 }
 
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void DetectorConstruction::SetWallThickness(G4double thickness)
+{
+  if (2*thickness >= std::min(fTank_x, fTank_y)) {
+    G4cout << "\n--> warning from DetectorConstruction::SetWallThickness : "
+           << G4BestUnit(thickness,"Length") << " leaves no chamber" << G4endl;
+    return;
+  }
+  fSideThk = thickness;
+  fChamber_x = fTank_x - 2*fSideThk;
+  fChamber_y = fTank_y - 2*fSideThk;
+  G4RunManager::GetRunManager()->ReinitializeGeometry();
+}
+
 
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
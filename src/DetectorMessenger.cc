@@ -33,6 +33,7 @@
 #include "DetectorMessenger.hh"
 
 #include "DetectorConstruction.hh"
+#include "ScoringWorld.hh"
 #include "G4UIdirectory.hh"
 #include "G4UIcommand.hh"
 #include "G4UIparameter.hh"
@@ -46,7 +47,7 @@
 DetectorMessenger::DetectorMessenger(DetectorConstruction * Det)
 :G4UImessenger(), 
  fDetector(Det), fTestemDir(0), fDetDir(0), fMaterCmd(0), fSizeCmd(0),
- fIsotopeCmd(0)
+ fIsotopeCmd(0), fMeshCmd(0), fWallCmd(0)
 { 
   fTestemDir = new G4UIdirectory("/testhadr/");
   fTestemDir->SetGuidance("commands specific to this example");
@@ -97,6 +98,29 @@ DetectorMessenger::DetectorMessenger(DetectorConstruction * Det)
   fIsotopeCmd->SetParameter(unitPrm);
   //
   fIsotopeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);  
+
+  fMeshCmd = new G4UIcommand("/testhadr/det/setMesh",this);
+  fMeshCmd->SetGuidance("Voxel mesh of the dose-rate tally over the room,");
+  fMeshCmd->SetGuidance("in a parallel world: nb of voxels along x, y, z.");
+  fMeshCmd->SetGuidance("0 0 0 : no mesh (default)");
+  //
+  const char* axis[] = { "nx", "ny", "nz" };
+  for (G4int i=0; i<3; ++i) {
+    G4UIparameter* nbPrm = new G4UIparameter(axis[i],'i',false);
+    nbPrm->SetGuidance("nb of voxels");
+    nbPrm->SetParameterRange(G4String(axis[i]) + ">=0");
+    fMeshCmd->SetParameter(nbPrm);
+  }
+  //
+  fMeshCmd->AvailableForStates(G4State_PreInit);
+
+  fWallCmd = new G4UIcmdWithADoubleAndUnit("/testhadr/det/setWallThickness",this);
+  fWallCmd->SetGuidance("Thickness of the side walls of the tank (default 45 cm);");
+  fWallCmd->SetGuidance("the chamber is narrowed or widened to match.");
+  fWallCmd->SetParameterName("thickness",false);
+  fWallCmd->SetRange("thickness>0.");
+  fWallCmd->SetUnitCategory("Length");
+  fWallCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -106,6 +130,8 @@ DetectorMessenger::~DetectorMessenger()
   delete fMaterCmd;
   delete fSizeCmd;
   delete fIsotopeCmd;
+  delete fMeshCmd;
+  delete fWallCmd;
   delete fDetDir;
   delete fTestemDir;
 }
@@ -131,6 +157,17 @@ void DetectorMessenger::SetNewValue(G4UIcommand* command,G4String newValue)
      fDetector->MaterialWithSingleIsotope (name,name,dens,Z,A);
      fDetector->SetMaterial(name);    
    }   
+
+  if (command == fMeshCmd)
+   {
+     G4int nx, ny, nz;
+     std::istringstream is(newValue);
+     is >> nx >> ny >> nz;
+     fDetector->GetScoringWorld()->SetNbVoxels(nx,ny,nz);
+   }
+
+  if (command == fWallCmd)
+   { fDetector->SetWallThickness(fWallCmd->GetNewDoubleValue(newValue)); }
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
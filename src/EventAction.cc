@@ -43,6 +43,7 @@
 #include "G4UnitsTable.hh"
 #include "G4ParticleGun.hh"
 #include "PrimaryGeneratorAction.hh"
+#include "CrossingBuffer.hh"
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -59,8 +60,11 @@ EventAction::~EventAction()
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void EventAction::BeginOfEventAction(const G4Event*)
+void EventAction::BeginOfEventAction(const G4Event* evt)
 {
+  // tag the boundary crossings of this event
+  if (fRun) fRun->GetCrossingBuffer()->SetEventID(evt->GetEventID());
+
   // reset event parameters:
   neutronEnergy_gen = 0.;
   neutronEnergy_exitshield = 0.;
@@ -84,6 +88,11 @@ void EventAction::EndOfEventAction(const G4Event* evt)
 {
 //----------------------------------------------------------------- 
   if(!fRun) return;
+
+  // per-event doses of the lab walls and points, for their relative error
+  Run* run = fRun->GetRun();
+  run->GetSurfaceTally()->EndOfEvent();
+  run->GetPointTally()->EndOfEvent();
   
   const PrimaryGeneratorAction* generator
    = static_cast<const PrimaryGeneratorAction*>
@@ -0,0 +1,123 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file ExpTransformMessenger.cc
+/// \brief Implementation of the ExpTransformMessenger class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "ExpTransformMessenger.hh"
+
+#include "ExpTransformPhysics.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithoutParameter.hh"
+#include "G4UIcmdWith3VectorAndUnit.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ExpTransformMessenger::ExpTransformMessenger(ExpTransformPhysics* physics)
+:G4UImessenger(), fPhysics(physics),
+ fExpDir(0), fStretchCmd(0), fVolumeCmd(0), fClearCmd(0), fCenterCmd(0)
+{
+  // the settings are read by the shared physics constructor: master only
+  G4bool broadcast = false;
+  fExpDir = new G4UIdirectory("/testhadr/bias/exp/",broadcast);
+  fExpDir->SetGuidance("exponential transform in the shield");
+
+  fStretchCmd = new G4UIcommand("/testhadr/bias/exp/stretch",this);
+  fStretchCmd->SetGuidance("Stretching parameter p of a particle: its cross");
+  fStretchCmd->SetGuidance("sections are scaled by (1 - p mu), mu the cosine");
+  fStretchCmd->SetGuidance("to the radial direction from the source.");
+  fStretchCmd->SetGuidance("0 : analog (default)");
+  //
+  G4UIparameter* particlePrm = new G4UIparameter("particle",'s',false);
+  particlePrm->SetParameterCandidates("neutron gamma");
+  fStretchCmd->SetParameter(particlePrm);
+  //
+  G4UIparameter* stretchPrm = new G4UIparameter("p",'d',false);
+  stretchPrm->SetParameterRange("p>=0. && p<1.");
+  fStretchCmd->SetParameter(stretchPrm);
+  //
+  fStretchCmd->AvailableForStates(G4State_PreInit);
+
+  fVolumeCmd = new G4UIcmdWithAString("/testhadr/bias/exp/addVolume",this);
+  fVolumeCmd->SetGuidance("Apply the transform in a logical volume (default Tank)");
+  fVolumeCmd->SetParameterName("volume",false);
+  fVolumeCmd->AvailableForStates(G4State_PreInit);
+
+  fClearCmd = new G4UIcmdWithoutParameter("/testhadr/bias/exp/clearVolumes",this);
+  fClearCmd->SetGuidance("Remove all the volumes of the transform");
+  fClearCmd->AvailableForStates(G4State_PreInit);
+
+  fCenterCmd = new G4UIcmdWith3VectorAndUnit("/testhadr/bias/exp/center",this);
+  fCenterCmd->SetGuidance("Centre of the radial preferred direction");
+  fCenterCmd->SetGuidance("(default: the source, 0 0 -80 cm)");
+  fCenterCmd->SetParameterName("x","y","z",false);
+  fCenterCmd->SetUnitCategory("Length");
+  fCenterCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ExpTransformMessenger::~ExpTransformMessenger()
+{
+  delete fStretchCmd;
+  delete fVolumeCmd;
+  delete fClearCmd;
+  delete fCenterCmd;
+  delete fExpDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ExpTransformMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fStretchCmd)
+   {
+     G4String particle;
+     G4double p;
+     std::istringstream is(newValue);
+     is >> particle >> p;
+     fPhysics->SetStretch(particle, p);
+   }
+
+  if (command == fVolumeCmd)
+   { fPhysics->AddVolume(newValue); }
+
+  if (command == fClearCmd)
+   { fPhysics->ClearVolumes(); }
+
+  if (command == fCenterCmd)
+   { fPhysics->SetCenter(fCenterCmd->GetNew3VectorValue(newValue)); }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,159 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file ExpTransformOperator.cc
+/// \brief Implementation of the ExpTransformOperator class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "ExpTransformOperator.hh"
+#include "ExpTransformPhysics.hh"
+
+#include "G4BiasingProcessInterface.hh"
+#include "G4BiasingProcessSharedData.hh"
+#include "G4BOptnChangeCrossSection.hh"
+#include "G4LogicalVolume.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4Neutron.hh"
+#include "G4Gamma.hh"
+#include "G4ProcessManager.hh"
+#include "G4Track.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ExpTransformOperator::ExpTransformOperator(const ExpTransformPhysics* physics)
+  : G4VBiasingOperator("ExpTransformOperator"), fPhysics(physics)
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ExpTransformOperator::~ExpTransformOperator()
+{
+  std::map<const G4BiasingProcessInterface*, G4BOptnChangeCrossSection*>
+    ::iterator it;
+  for (it = fOperation.begin(); it != fOperation.end(); ++it) delete it->second;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ExpTransformOperator::AddOperations(const G4ParticleDefinition* particle)
+{
+  const G4BiasingProcessSharedData* sharedData
+    = G4BiasingProcessInterface::GetSharedData(particle->GetProcessManager());
+  if (!sharedData) return;
+
+  const std::vector<const G4BiasingProcessInterface*>& wrappers
+    = sharedData->GetPhysicsBiasingProcessInterfaces();
+  for (size_t i=0; i<wrappers.size(); ++i) {
+    if (fOperation.count(wrappers[i])) continue;
+    G4String name = "expTransform-" + wrappers[i]->GetWrappedProcess()->GetProcessName();
+    fOperation[wrappers[i]] = new G4BOptnChangeCrossSection(name);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ExpTransformOperator::StartRun()
+{
+  AddOperations(G4Neutron::Definition());
+  AddOperations(G4Gamma::Definition());
+
+  // (re)attach to the volumes of the current geometry
+  const G4LogicalVolumeStore* store = G4LogicalVolumeStore::GetInstance();
+  for (size_t i=0; i<store->size(); ++i) {
+    const G4LogicalVolume* volume = (*store)[i];
+    if (!fPhysics->IsTransformed(volume)) continue;
+    G4VBiasingOperator* current = GetBiasingOperator(volume);
+    if (current == this) continue;
+    if (current) {
+      G4cout << "\n--> warning from ExpTransformOperator::StartRun : "
+             << volume->GetName() << " already biased by "
+             << current->GetName() << "; no exponential transform there"
+             << G4endl;
+      continue;
+    }
+    AttachTo(volume);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4VBiasingOperation* ExpTransformOperator::ProposeOccurenceBiasingOperation(
+                                 const G4Track* track,
+                                 const G4BiasingProcessInterface* callingProcess)
+{
+  G4double stretch = fPhysics->GetStretch(track->GetDefinition());
+  if (stretch <= 0.) return 0;
+
+  std::map<const G4BiasingProcessInterface*, G4BOptnChangeCrossSection*>
+    ::iterator it = fOperation.find(callingProcess);
+  if (it == fOperation.end()) return 0;
+  G4BOptnChangeCrossSection* operation = it->second;
+
+  G4double analogLength
+    = callingProcess->GetWrappedProcess()->GetCurrentInteractionLength();
+  if (analogLength > DBL_MAX/10.) return 0;
+
+  // mu at the start of the step, radial direction from the source centre
+  G4ThreeVector radial = track->GetPosition() - fPhysics->GetCenter();
+  G4double mu = (radial.mag2() > 0.) ?
+                track->GetMomentumDirection().dot(radial.unit()) : 0.;
+  G4double biasedXS = (1. - stretch*mu)/analogLength;
+
+  // a new interaction length after an interaction, else the remaining one
+  // is carried over with the cross section of the new step
+  G4VBiasingOperation* previous
+    = callingProcess->GetPreviousOccurenceBiasingOperation();
+  if (previous != operation || operation->GetInteractionOccured()) {
+    operation->SetBiasedCrossSection(biasedXS);
+    operation->Sample();
+  } else {
+    operation->UpdateForStep(callingProcess->GetPreviousStepSize());
+    operation->SetBiasedCrossSection(biasedXS);
+    operation->UpdateForStep(0.);
+  }
+  return operation;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ExpTransformOperator::OperationApplied(const G4BiasingProcessInterface* callingProcess,
+                                 G4BiasingAppliedCase,
+                                 G4VBiasingOperation* occurenceOperationApplied,
+                                 G4double,
+                                 G4VBiasingOperation*,
+                                 const G4VParticleChange*)
+{
+  std::map<const G4BiasingProcessInterface*, G4BOptnChangeCrossSection*>
+    ::iterator it = fOperation.find(callingProcess);
+  if (it != fOperation.end() && it->second == occurenceOperationApplied) {
+    it->second->SetInteractionOccured();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,125 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file ExpTransformPhysics.cc
+/// \brief Implementation of the ExpTransformPhysics class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "ExpTransformPhysics.hh"
+#include "ExpTransformMessenger.hh"
+#include "ExpTransformOperator.hh"
+
+#include "G4BiasingHelper.hh"
+#include "G4BiasingProcessInterface.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Neutron.hh"
+#include "G4Gamma.hh"
+#include "G4ProcessManager.hh"
+#include "G4ProcessVector.hh"
+#include "G4SystemOfUnits.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ExpTransformPhysics::ExpTransformPhysics()
+  : G4VPhysicsConstructor("ExpTransform"), fMessenger(0),
+    fNeutronStretch(0.), fGammaStretch(0.), fCenter(0., 0., -0.8*m)
+{
+  fVolume.push_back("Tank");
+  fMessenger = new ExpTransformMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ExpTransformPhysics::~ExpTransformPhysics()
+{
+  delete fMessenger;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ExpTransformPhysics::SetStretch(const G4String& particle, G4double p)
+{
+  if (particle == "neutron") fNeutronStretch = p;
+  else                       fGammaStretch = p;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double ExpTransformPhysics::GetStretch(const G4ParticleDefinition* particle) const
+{
+  if (particle == G4Neutron::Definition()) return fNeutronStretch;
+  if (particle == G4Gamma::Definition())   return fGammaStretch;
+  return 0.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool ExpTransformPhysics::IsTransformed(const G4LogicalVolume* volume) const
+{
+  for (size_t i=0; i<fVolume.size(); ++i) {
+    if (volume->GetName() == fVolume[i]) return true;
+  }
+  return false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ExpTransformPhysics::WrapProcesses(const G4ParticleDefinition* particle)
+{
+  // the interactions, not transportation nor the other biasing processes
+  G4ProcessManager* pManager = particle->GetProcessManager();
+  G4ProcessVector* processes = pManager->GetProcessList();
+  std::vector<G4String> names;
+  for (G4int i=0; i<G4int(processes->size()); ++i) {
+    G4VProcess* process = (*processes)[i];
+    if (dynamic_cast<G4BiasingProcessInterface*>(process)) continue;
+    G4ProcessType type = process->GetProcessType();
+    if (type == fHadronic || type == fElectromagnetic) {
+      names.push_back(process->GetProcessName());
+    }
+  }
+  for (size_t i=0; i<names.size(); ++i) {
+    G4BiasingHelper::ActivatePhysicsBiasing(pManager, names[i]);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ExpTransformPhysics::ConstructProcess()
+{
+  if (fNeutronStretch <= 0. && fGammaStretch <= 0.) return;
+
+  if (fNeutronStretch > 0.) WrapProcesses(G4Neutron::Definition());
+  if (fGammaStretch > 0.)   WrapProcesses(G4Gamma::Definition());
+
+  // thread-local operator, attached to the volumes at each run
+  new ExpTransformOperator(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,228 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file FluenceToDose.cc
+/// \brief Implementation of the FluenceToDose class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "FluenceToDose.hh"
+#include "CrossingBuffer.hh"
+
+#include "G4SystemOfUnits.hh"
+
+#include <fstream>
+#include <sstream>
+
+// ICRP Publication 74 (1996), H*(10)/fluence [pSv cm2] versus E [MeV]
+//
+namespace {
+  const G4double kNeutronE[] = {
+    1.e-9, 1.e-8, 2.53e-8, 1.e-7, 2.e-7, 5.e-7, 1.e-6, 2.e-6, 5.e-6,
+    1.e-5, 2.e-5, 5.e-5, 1.e-4, 2.e-4, 5.e-4, 1.e-3, 2.e-3, 5.e-3,
+    1.e-2, 2.e-2, 3.e-2, 5.e-2, 7.e-2, 0.1, 0.15, 0.2, 0.3, 0.5, 0.7,
+    0.9, 1., 1.2, 2., 3., 4., 5., 6., 7., 8., 9., 10., 12., 14., 15.,
+    16., 18., 20. };
+  const G4double kNeutronH[] = {
+    6.6, 9.0, 10.6, 12.9, 13.5, 13.6, 13.3, 12.9, 12.0,
+    11.3, 10.6, 9.9, 9.4, 8.9, 8.3, 7.9, 7.7, 8.0,
+    10.5, 16.6, 23.7, 41.1, 60.0, 88.0, 132., 170., 233., 322., 375.,
+    400., 416., 425., 420., 412., 408., 405., 400., 405., 409., 420.,
+    440., 480., 520., 540., 555., 570., 600. };
+
+  const G4double kGammaE[] = {
+    0.01, 0.015, 0.02, 0.03, 0.04, 0.05, 0.06, 0.08, 0.1, 0.15, 0.2,
+    0.3, 0.4, 0.5, 0.6, 0.8, 1., 1.5, 2., 3., 4., 5., 6., 8., 10. };
+  const G4double kGammaH[] = {
+    0.061, 0.83, 1.05, 0.81, 0.64, 0.55, 0.51, 0.53, 0.61, 0.89, 1.20,
+    1.80, 2.38, 2.93, 3.44, 4.38, 5.20, 6.90, 8.60, 11.1, 13.4, 15.5,
+    17.6, 21.6, 25.6 };
+
+  const G4int kCellsPerDecade = 100;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+FluenceToDose::FluenceToDose()
+{
+  for (G4int p=0; p<kNbParticles; ++p) UseICRP74(p);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+FluenceToDose::~FluenceToDose()
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void FluenceToDose::GetICRP74(G4int particle,
+                              std::vector<G4double>& energy,
+                              std::vector<G4double>& coefficient)
+{
+  if (particle == CrossingRecord::kNeutron) {
+    size_t n = sizeof(kNeutronE)/sizeof(G4double);
+    energy.assign(kNeutronE, kNeutronE+n);
+    coefficient.assign(kNeutronH, kNeutronH+n);
+  } else {
+    size_t n = sizeof(kGammaE)/sizeof(G4double);
+    energy.assign(kGammaE, kGammaE+n);
+    coefficient.assign(kGammaH, kGammaH+n);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void FluenceToDose::UseICRP74(G4int particle)
+{
+  std::vector<G4double> energy, coefficient;
+  GetICRP74(particle, energy, coefficient);
+  BuildGrid(particle, energy, coefficient, "ICRP-74 H*(10)");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool FluenceToDose::LoadTable(G4int particle, const G4String& fileName)
+{
+  std::ifstream file(fileName);
+  if (!file) {
+    G4cout << "\n--> warning from FluenceToDose::LoadTable : "
+           << fileName << " not found, table unchanged" << G4endl;
+    return false;
+  }
+
+  std::vector<G4double> energy, coefficient;
+  std::string line;
+  while (std::getline(file, line)) {
+    line = line.substr(0, line.find('#'));
+    std::istringstream columns(line);
+    G4double e, h;
+    if (!(columns >> e >> h)) continue;
+    if (e <= 0. || h < 0. || (!energy.empty() && e <= energy.back())) {
+      G4cout << "\n--> warning from FluenceToDose::LoadTable : "
+             << fileName << " : energies must be positive and increasing,"
+             << " table unchanged" << G4endl;
+      return false;
+    }
+    energy.push_back(e);
+    coefficient.push_back(h);
+  }
+  if (energy.size() < 2) {
+    G4cout << "\n--> warning from FluenceToDose::LoadTable : "
+           << fileName << " : less than 2 points, table unchanged" << G4endl;
+    return false;
+  }
+
+  BuildGrid(particle, energy, coefficient, fileName);
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void FluenceToDose::SetConstant(G4int particle, G4double coefficient)
+{
+  std::vector<G4double> energy(2), h(2, coefficient);
+  energy[0] = 1.e-11;
+  energy[1] = 1.e+3;
+  std::ostringstream name;
+  name << "constant " << coefficient << " pSv cm2";
+  BuildGrid(particle, energy, h, name.str());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double FluenceToDose::Interpolate(const std::vector<G4double>& energy,
+                                    const std::vector<G4double>& coefficient,
+                                    G4double e)
+{
+  if (e <= energy.front()) return coefficient.front();
+  if (e >= energy.back())  return coefficient.back();
+
+  size_t i = std::upper_bound(energy.begin(), energy.end(), e)
+           - energy.begin();
+  G4double e1 = energy[i-1], e2 = energy[i];
+  G4double h1 = coefficient[i-1], h2 = coefficient[i];
+
+  // log-log, or lin-log where a coefficient is 0
+  G4double t = std::log(e/e1)/std::log(e2/e1);
+  if (h1 > 0. && h2 > 0.) return h1*std::pow(h2/h1, t);
+  return h1 + (h2-h1)*t;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void FluenceToDose::BuildGrid(G4int particle,
+                              const std::vector<G4double>& energy,
+                              const std::vector<G4double>& coefficient,
+                              const G4String& name)
+{
+  Grid& grid = fGrid[particle];
+  G4double logEmin = std::log(energy.front()*MeV);
+  G4double logEmax = std::log(energy.back()*MeV);
+  G4int nbCells = std::max(1, G4int(std::ceil(
+                    (logEmax-logEmin)/std::log(10.)*kCellsPerDecade)));
+
+  grid.logEmin  = logEmin;
+  grid.invStep  = nbCells/(logEmax-logEmin);
+  grid.uMax     = nbCells;
+  grid.lastCell = nbCells-1;
+  grid.name     = name;
+
+  // the table is sampled at the nodes; h is linear in u inside a cell
+  grid.cells.resize(nbCells);
+  G4double step = (logEmax-logEmin)/nbCells;
+  G4double h1 = coefficient.front();
+  for (G4int i=0; i<nbCells; ++i) {
+    G4double e2 = std::exp(logEmin + (i+1)*step)/MeV;
+    G4double h2 = (i == nbCells-1) ? coefficient.back()
+                                   : Interpolate(energy, coefficient, e2);
+    grid.cells[i].slope     = h2 - h1;
+    grid.cells[i].intercept = h1 - (h2-h1)*i;
+    h1 = h2;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void FluenceToDose::Convert(G4int particle, const G4double* energy,
+                            G4double* coefficient, size_t n) const
+{
+  // same arithmetic as GetCoefficient, hoisted out of the loop
+  const Grid& grid = fGrid[particle];
+  const Cell* cells = grid.cells.data();
+  const G4double logEmin = grid.logEmin, invStep = grid.invStep;
+  const G4double uMax = grid.uMax;
+  const G4int lastCell = grid.lastCell;
+
+  for (size_t k=0; k<n; ++k) {
+    G4double u = (std::log(energy[k]) - logEmin)*invStep;
+    u = std::min(std::max(u, 0.), uMax);
+    const Cell& cell = cells[std::min(G4int(u), lastCell)];
+    coefficient[k] = cell.intercept + cell.slope*u;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
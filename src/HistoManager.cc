@@ -31,20 +31,42 @@
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 #include "HistoManager.hh"
+#include "HistoMessenger.hh"
+#include "CrossingWriter.hh"
+#include "CompactSchema.hh"
+#include "SurfaceTally.hh"
 #include "G4UnitsTable.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Threading.hh"
+#include "G4Version.hh"
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 HistoManager::HistoManager()
-  : fFileName("Hadr04")
+  : fFileName("Hadr04"), fSchema(kDouble), fNtuplesBooked(false),
+    fMergeNtuples(false),
+    fSurfaceTally(false), fTallyBinSize(0.), fSourceRate(0.),
+    fSparseVoxelSize(0.), fPointMinDistance(5*cm), fPointCacheCell(2*cm),
+    fSurfaceMapsBooked(false),
+    fNtupleCrossings(true), fBinaryCrossings(false), fHistoMessenger(0)
 {
+  // tally defaults
+  SurfaceTally defaults;
+  fTallyBinSize = defaults.GetBinSize();
+  fSourceRate   = defaults.GetSourceRate();
+  for (G4int p=0; p<SurfaceTally::kNbParticles; ++p) {
+    for (G4int k=0; k<SurfaceTally::kNbFaces; ++k) fSurfaceMapID[p][k] = -1;
+  }
+
   Book();
+  fHistoMessenger = new HistoMessenger(this);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 HistoManager::~HistoManager()
 {
+  delete fHistoMessenger;
   delete G4AnalysisManager::Instance();
 }
 
@@ -80,21 +102,218 @@ void HistoManager::Book()
     analysisManager->SetH1Activation(ih, true);
   }
 
-  // ID=0, neutron transport
-  analysisManager->CreateNtuple("nFlux", "Neutrons hitting lab walls"); //id = 0
-  analysisManager->CreateNtupleDColumn("x");
-  analysisManager->CreateNtupleDColumn("y");
-  analysisManager->CreateNtupleDColumn("z");
-  analysisManager->CreateNtupleDColumn("KE");
-  analysisManager->FinishNtuple();
-
-    // ID=1, gamma transport
-  analysisManager->CreateNtuple("gFlux", "Gammas hitting lab walls"); //id = 1
-  analysisManager->CreateNtupleDColumn("x");
-  analysisManager->CreateNtupleDColumn("y");
-  analysisManager->CreateNtupleDColumn("z");
-  analysisManager->CreateNtupleDColumn("E");
-  analysisManager->FinishNtuple();
+  // the ntuples are booked at begin of run, once the schema is known
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void HistoManager::SetNtupleSchema(const G4String& schema)
+{
+  if (fNtuplesBooked) {
+    G4cout << "\n--> warning from HistoManager::SetNtupleSchema : "
+           << "ntuples already booked, schema unchanged" << G4endl;
+    return;
+  }
+  if      (schema == "float")   fSchema = kFloat;
+  else if (schema == "compact") fSchema = kCompact;
+  else                          fSchema = kDouble;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void HistoManager::BookNtuples()
+{
+  if (fNtuplesBooked) return;
+  fNtuplesBooked = true;
+
+  G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+
+  // merging must be set before the ntuples are created: one output file,
+  // filled by the workers while the run goes on
+  if (fMergeNtuples && G4Threading::IsMultithreadedApplication()) {
+#if G4VERSION_NUMBER >= 1050
+    analysisManager->SetNtupleRowWise(true);
+    analysisManager->SetNtupleMerging(true);
+#else
+    analysisManager->SetNtupleMerging(true, 0, true);   //row-wise
+#endif
+  }
+
+  // ID=0, neutron transport; ID=1, gamma transport
+  // the column names are the same in all schemas:
+  //   double  : x,y,z [m], KE|E [MeV] and weight w as doubles (default)
+  //   float   : same columns as floats, + particle code and weight w
+  //   compact : fixed-point x,y,z and log-quantized KE|E (CompactSchema.hh)
+  //             as ints, + particle code and weight w
+  const char* name[]   = { "nFlux", "gFlux" };
+  const char* title[]  = { "Neutrons hitting lab walls",
+                           "Gammas hitting lab walls" };
+  const char* column[] = { "x", "y", "z", 0 };
+  const char* energy[] = { "KE", "E" };
+
+  for (G4int id=0; id<2; ++id) {
+    analysisManager->CreateNtuple(name[id], title[id]);
+    column[3] = energy[id];
+    for (G4int k=0; k<4; ++k) {
+      if      (fSchema == kDouble) analysisManager->CreateNtupleDColumn(column[k]);
+      else if (fSchema == kFloat)  analysisManager->CreateNtupleFColumn(column[k]);
+      else                         analysisManager->CreateNtupleIColumn(column[k]);
+    }
+    if (fSchema == kDouble) {
+      analysisManager->CreateNtupleDColumn("w");
+    } else {
+      analysisManager->CreateNtupleIColumn("particle");
+      analysisManager->CreateNtupleFColumn("w");
+    }
+    analysisManager->FinishNtuple();
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void HistoManager::SetCrossingOutput(const G4String& output)
+{
+  fNtupleCrossings = (output == "ntuple" || output == "both");
+  fBinaryCrossings = (output == "binary" || output == "both");
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void HistoManager::SetTallyBinSize(G4double size)
+{
+  if (fSurfaceMapsBooked) {
+    G4cout << "\n--> warning from HistoManager::SetTallyBinSize : "
+           << "wall maps already booked, bin size unchanged" << G4endl;
+    return;
+  }
+  if (size > 0.) fTallyBinSize = size;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void HistoManager::ConfigureSurfaceTally(SurfaceTally* tally) const
+{
+  tally->SetBinSize(fTallyBinSize);
+  tally->SetSourceRate(fSourceRate);
+  tally->SetDoseConversion(&fDoseConversion);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void HistoManager::ConfigureMeshTally(MeshTally* tally) const
+{
+  tally->SetSourceRate(fSourceRate);
+  tally->SetDoseConversion(&fDoseConversion);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void HistoManager::ConfigureSparseMesh(SparseMeshTally* tally) const
+{
+  tally->SetSourceRate(fSourceRate);
+  tally->SetDoseConversion(&fDoseConversion);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void HistoManager::ConfigurePointTally(PointDetectorTally* tally) const
+{
+  tally->SetSourceRate(fSourceRate);
+  tally->SetDoseConversion(&fDoseConversion);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void HistoManager::BookSurfaceMaps(const SurfaceTally& tally)
+{
+  if (fSurfaceMapsBooked) return;
+  fSurfaceMapsBooked = true;
+
+  // same binning in all threads, so that the H2s merge; axes in m
+  G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+  const char* prefix[] = { "n", "g" };
+  const char* symbol[] = { "D_{n}", "D_{#gamma}" };
+  for (G4int p=0; p<SurfaceTally::kNbParticles; ++p) {
+    for (G4int k=0; k<SurfaceTally::kNbFaces; ++k) {
+      G4String face  = SurfaceTally::GetFaceName(k);
+      G4String name  = prefix[p] + face;
+      G4String title = G4String(symbol[p]) + " on " + face
+                     + (k == SurfaceTally::kCeiling ? "" : " Wall")
+                     + " [#muSv/h]";
+      fSurfaceMapID[p][k] =
+        analysisManager->CreateH2(name, title,
+                  tally.GetNbBinsU(k), tally.GetUMin(k)/m, tally.GetUMax(k)/m,
+                  tally.GetNbBinsV(k), tally.GetVMin(k)/m, tally.GetVMax(k)/m);
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void HistoManager::FillSurfaceMaps(const SurfaceTally& tally, G4int nbEvents)
+{
+  if (!fSurfaceMapsBooked || !tally.IsBooked()) return;
+
+  // one weighted entry at the centre of each bin
+  G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+  G4double binSize = tally.GetBinSize();
+  for (G4int p=0; p<SurfaceTally::kNbParticles; ++p) {
+    for (G4int k=0; k<SurfaceTally::kNbFaces; ++k) {
+      for (G4int iv=0; iv<tally.GetNbBinsV(k); ++iv) {
+        G4double v = tally.GetVMin(k) + (iv+0.5)*binSize;
+        for (G4int iu=0; iu<tally.GetNbBinsU(k); ++iu) {
+          G4double rate = tally.GetDoseRate(p, k, iu, iv, nbEvents);
+          if (rate == 0.) continue;
+          G4double u = tally.GetUMin(k) + (iu+0.5)*binSize;
+          analysisManager->FillH2(fSurfaceMapID[p][k], u/m, v/m, rate);
+        }
+      }
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void HistoManager::WriteCrossings(const CrossingRecord* records, size_t n)
+{
+  // binary records go to the writer thread
+  if (fBinaryCrossings && CrossingWriter::Instance()->IsOpen()) {
+    CrossingWriter::Instance()->WriteCrossings(records, n);
+  }
+  if (!fNtupleCrossings) return;
+
+  G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+  for (size_t i=0; i<n; ++i) {
+    const CrossingRecord& rec = records[i];
+    G4int id = rec.particle;      //ntuple ID
+    if (id == CrossingRecord::kGamma) analysisManager->FillH1(1,rec.energy,rec.weight);
+    switch (fSchema) {
+      case kDouble:
+        analysisManager->FillNtupleDColumn(id,0,rec.x);
+        analysisManager->FillNtupleDColumn(id,1,rec.y);
+        analysisManager->FillNtupleDColumn(id,2,rec.z);
+        analysisManager->FillNtupleDColumn(id,3,rec.energy);
+        analysisManager->FillNtupleDColumn(id,4,rec.weight);
+        break;
+      case kFloat:
+        analysisManager->FillNtupleFColumn(id,0,rec.x);
+        analysisManager->FillNtupleFColumn(id,1,rec.y);
+        analysisManager->FillNtupleFColumn(id,2,rec.z);
+        analysisManager->FillNtupleFColumn(id,3,rec.energy);
+        break;
+      case kCompact:
+        analysisManager->FillNtupleIColumn(id,0,CompactSchema::EncodePosition(rec.x));
+        analysisManager->FillNtupleIColumn(id,1,CompactSchema::EncodePosition(rec.y));
+        analysisManager->FillNtupleIColumn(id,2,CompactSchema::EncodePosition(rec.z));
+        analysisManager->FillNtupleIColumn(id,3,CompactSchema::EncodeEnergy(rec.energy/MeV));
+        break;
+    }
+    if (fSchema != kDouble) {
+      analysisManager->FillNtupleIColumn(id,4,rec.particle);
+      analysisManager->FillNtupleFColumn(id,5,rec.weight);
+    }
+    analysisManager->AddNtupleRow(id);
+  }
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
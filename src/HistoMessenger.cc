@@ -0,0 +1,286 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file HistoMessenger.cc
+/// \brief Implementation of the HistoMessenger class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "HistoMessenger.hh"
+
+#include "HistoManager.hh"
+#include "G4UIdirectory.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithABool.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithADoubleAndUnit.hh"
+#include "G4UIcmdWith3VectorAndUnit.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+HistoMessenger::HistoMessenger(HistoManager* histo)
+:G4UImessenger(), fHistoManager(histo),
+ fOutputDir(0), fCrossingsCmd(0), fSchemaCmd(0),
+ fMergeCmd(0), fPhaseSpaceCmd(0), fGammaSourceCmd(0),
+ fTallyDir(0), fSurfaceCmd(0), fBinSizeCmd(0), fSourceRateCmd(0),
+ fNeutronFactorCmd(0), fGammaFactorCmd(0), fNeutronTableCmd(0),
+ fGammaTableCmd(0), fSparseVoxelCmd(0), fPointCmd(0), fClearPointsCmd(0),
+ fPointDistanceCmd(0), fPointCacheCmd(0)
+{ 
+  fOutputDir = new G4UIdirectory("/testhadr/output/");
+  fOutputDir->SetGuidance("output format commands");
+   
+  fCrossingsCmd = new G4UIcmdWithAString("/testhadr/output/crossings",this);
+  fCrossingsCmd->SetGuidance("Destination of the lab-exit crossing records:");
+  fCrossingsCmd->SetGuidance("  ntuple : nFlux/gFlux ntuples (default)");
+  fCrossingsCmd->SetGuidance("  binary : <fileName>_crossings.bin, written by");
+  fCrossingsCmd->SetGuidance("           a background writer thread");
+  fCrossingsCmd->SetGuidance("  both   : ntuples and binary file");
+  fCrossingsCmd->SetGuidance("  none   : not written (wall dose maps only)");
+  fCrossingsCmd->SetParameterName("output",false);
+  fCrossingsCmd->SetCandidates("ntuple binary both none");
+  fCrossingsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fSchemaCmd = new G4UIcmdWithAString("/testhadr/output/schema",this);
+  fSchemaCmd->SetGuidance("Column types of the nFlux/gFlux ntuples:");
+  fSchemaCmd->SetGuidance("  double  : x,y,z [m] and KE|E [MeV] as doubles (default)");
+  fSchemaCmd->SetGuidance("  float   : same columns as floats");
+  fSchemaCmd->SetGuidance("  compact : fixed-point x,y,z (1 mm) and log-quantized");
+  fSchemaCmd->SetGuidance("            KE|E as ints (see CompactSchema.hh)");
+  fSchemaCmd->SetGuidance("float and compact add a particle code and a weight w.");
+  fSchemaCmd->SetGuidance("Must be set before the first run.");
+  fSchemaCmd->SetParameterName("schema",false);
+  fSchemaCmd->SetCandidates("double float compact");
+  fSchemaCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fMergeCmd = new G4UIcmdWithABool("/testhadr/output/mergeNtuples",this);
+  fMergeCmd->SetGuidance("MT mode: write the ntuples of all threads, row-wise,");
+  fMergeCmd->SetGuidance("into one file while the run goes on, instead of");
+  fMergeCmd->SetGuidance("one file per thread. Must be set before the first run.");
+  fMergeCmd->SetParameterName("merge",false);
+  fMergeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fPhaseSpaceCmd = new G4UIcmdWithAString("/testhadr/output/phaseSpace",this);
+  fPhaseSpaceCmd->SetGuidance("Write every particle leaving the tank to a binary");
+  fPhaseSpaceCmd->SetGuidance("phase-space file, to be replayed as the source of");
+  fPhaseSpaceCmd->SetGuidance("later runs by /testhadr/gun/phaseSpace.");
+  fPhaseSpaceCmd->SetGuidance("  none : not written (default)");
+  fPhaseSpaceCmd->SetParameterName("fileName",false);
+  fPhaseSpaceCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fGammaSourceCmd = new G4UIcmdWithAString("/testhadr/output/gammaSource",this);
+  fGammaSourceCmd->SetGuidance("Neutron phase of a two-phase run: the secondary");
+  fGammaSourceCmd->SetGuidance("gammas (neutron captures, inelastic scatterings or");
+  fGammaSourceCmd->SetGuidance("other) are written to a source file and not");
+  fGammaSourceCmd->SetGuidance("transported; the gamma phase replays it with");
+  fGammaSourceCmd->SetGuidance("/testhadr/gun/phaseSpace.");
+  fGammaSourceCmd->SetGuidance("  none : gammas transported (default)");
+  fGammaSourceCmd->SetParameterName("fileName",false);
+  fGammaSourceCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fTallyDir = new G4UIdirectory("/testhadr/tally/");
+  fTallyDir->SetGuidance("dose-rate maps of the lab walls and ceiling");
+
+  fSurfaceCmd = new G4UIcmdWithABool("/testhadr/tally/surface",this);
+  fSurfaceCmd->SetGuidance("Score the neutrons and gammas leaving the room");
+  fSurfaceCmd->SetGuidance("into dose-rate maps of the walls (default false)");
+  fSurfaceCmd->SetParameterName("active",false);
+  fSurfaceCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fBinSizeCmd = new G4UIcmdWithADoubleAndUnit("/testhadr/tally/binSize",this);
+  fBinSizeCmd->SetGuidance("Size of the square bins of the wall maps.");
+  fBinSizeCmd->SetGuidance("Must be set before the first run.");
+  fBinSizeCmd->SetParameterName("size",false);
+  fBinSizeCmd->SetRange("size>0.");
+  fBinSizeCmd->SetUnitCategory("Length");
+  fBinSizeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fSourceRateCmd = new G4UIcmdWithADouble("/testhadr/tally/sourceRate",this);
+  fSourceRateCmd->SetGuidance("Primaries per second emitted by the generator,");
+  fSourceRateCmd->SetGuidance("normalisation of the dose rates (default 1e8)");
+  fSourceRateCmd->SetParameterName("rate",false);
+  fSourceRateCmd->SetRange("rate>0.");
+  fSourceRateCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fNeutronFactorCmd = new G4UIcmdWithADouble("/testhadr/tally/neutronDoseFactor",this);
+  fNeutronFactorCmd->SetGuidance("Constant fluence-to-dose coefficient of the");
+  fNeutronFactorCmd->SetGuidance("neutrons in pSv cm2, instead of a table");
+  fNeutronFactorCmd->SetParameterName("factor",false);
+  fNeutronFactorCmd->SetRange("factor>=0.");
+  fNeutronFactorCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fGammaFactorCmd = new G4UIcmdWithADouble("/testhadr/tally/gammaDoseFactor",this);
+  fGammaFactorCmd->SetGuidance("Constant fluence-to-dose coefficient of the");
+  fGammaFactorCmd->SetGuidance("gammas in pSv cm2, instead of a table");
+  fGammaFactorCmd->SetParameterName("factor",false);
+  fGammaFactorCmd->SetRange("factor>=0.");
+  fGammaFactorCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fNeutronTableCmd = new G4UIcmdWithAString("/testhadr/tally/neutronDoseTable",this);
+  fNeutronTableCmd->SetGuidance("Fluence-to-dose coefficients of the neutrons:");
+  fNeutronTableCmd->SetGuidance("  icrp74 : built-in ICRP-74 H*(10) (default)");
+  fNeutronTableCmd->SetGuidance("  <file> : columns E [MeV], h [pSv cm2]");
+  fNeutronTableCmd->SetParameterName("table",false);
+  fNeutronTableCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fGammaTableCmd = new G4UIcmdWithAString("/testhadr/tally/gammaDoseTable",this);
+  fGammaTableCmd->SetGuidance("Fluence-to-dose coefficients of the gammas:");
+  fGammaTableCmd->SetGuidance("  icrp74 : built-in ICRP-74 H*(10) (default)");
+  fGammaTableCmd->SetGuidance("  <file> : columns E [MeV], h [pSv cm2]");
+  fGammaTableCmd->SetParameterName("table",false);
+  fGammaTableCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fSparseVoxelCmd = new G4UIcmdWithADoubleAndUnit("/testhadr/tally/sparseVoxel",this);
+  fSparseVoxelCmd->SetGuidance("Size of the cubic voxels of the sparse track-length");
+  fSparseVoxelCmd->SetGuidance("mesh of the room; only the voxels crossed by a");
+  fSparseVoxelCmd->SetGuidance("neutron or a gamma are stored. 0: off (default)");
+  fSparseVoxelCmd->SetParameterName("size",false);
+  fSparseVoxelCmd->SetRange("size>=0.");
+  fSparseVoxelCmd->SetUnitCategory("Length");
+  fSparseVoxelCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fPointCmd = new G4UIcmdWith3VectorAndUnit("/testhadr/tally/addPoint",this);
+  fPointCmd->SetGuidance("Add a point detector: dose rate at this point from");
+  fPointCmd->SetGuidance("the next-event estimator of every emission and");
+  fPointCmd->SetGuidance("collision of the neutrons and gammas");
+  fPointCmd->SetParameterName("x","y","z",false);
+  fPointCmd->SetUnitCategory("Length");
+  fPointCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fClearPointsCmd = new G4UIcmdWithoutParameter("/testhadr/tally/clearPoints",this);
+  fClearPointsCmd->SetGuidance("Remove all the point detectors");
+  fClearPointsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fPointDistanceCmd = new G4UIcmdWithADoubleAndUnit("/testhadr/tally/pointMinDistance",this);
+  fPointDistanceCmd->SetGuidance("Collisions closer to a point detector count as");
+  fPointDistanceCmd->SetGuidance("this distance, which bounds the variance (default 5 cm)");
+  fPointDistanceCmd->SetParameterName("distance",false);
+  fPointDistanceCmd->SetRange("distance>0.");
+  fPointDistanceCmd->SetUnitCategory("Length");
+  fPointDistanceCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fPointCacheCmd = new G4UIcmdWithADoubleAndUnit("/testhadr/tally/pointCacheCell",this);
+  fPointCacheCmd->SetGuidance("Size of the cells of origins sharing one ray-traced");
+  fPointCacheCmd->SetGuidance("path to a point detector (default 2 cm). 0: every");
+  fPointCacheCmd->SetGuidance("ray is traced");
+  fPointCacheCmd->SetParameterName("size",false);
+  fPointCacheCmd->SetRange("size>=0.");
+  fPointCacheCmd->SetUnitCategory("Length");
+  fPointCacheCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+HistoMessenger::~HistoMessenger()
+{
+  delete fPointCacheCmd;
+  delete fPointDistanceCmd;
+  delete fClearPointsCmd;
+  delete fPointCmd;
+  delete fSparseVoxelCmd;
+  delete fGammaTableCmd;
+  delete fNeutronTableCmd;
+  delete fGammaFactorCmd;
+  delete fNeutronFactorCmd;
+  delete fSourceRateCmd;
+  delete fBinSizeCmd;
+  delete fSurfaceCmd;
+  delete fTallyDir;
+  delete fGammaSourceCmd;
+  delete fPhaseSpaceCmd;
+  delete fMergeCmd;
+  delete fSchemaCmd;
+  delete fCrossingsCmd;
+  delete fOutputDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void HistoMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{   
+  if (command == fCrossingsCmd)
+   {fHistoManager->SetCrossingOutput(newValue);}
+
+  if (command == fSchemaCmd)
+   {fHistoManager->SetNtupleSchema(newValue);}
+
+  if (command == fMergeCmd)
+   {fHistoManager->SetNtupleMerging(fMergeCmd->GetNewBoolValue(newValue));}
+
+  if (command == fPhaseSpaceCmd)
+   {fHistoManager->SetPhaseSpaceFile(newValue);}
+
+  if (command == fGammaSourceCmd)
+   {fHistoManager->SetGammaSourceFile(newValue);}
+
+  if (command == fSurfaceCmd)
+   {fHistoManager->SetSurfaceTally(fSurfaceCmd->GetNewBoolValue(newValue));}
+
+  if (command == fBinSizeCmd)
+   {fHistoManager->SetTallyBinSize(fBinSizeCmd->GetNewDoubleValue(newValue));}
+
+  if (command == fSourceRateCmd)
+   {fHistoManager->SetSourceRate(fSourceRateCmd->GetNewDoubleValue(newValue));}
+
+  FluenceToDose* dose = fHistoManager->GetDoseConversion();
+
+  if (command == fNeutronFactorCmd)
+   {dose->SetConstant(CrossingRecord::kNeutron,
+                      fNeutronFactorCmd->GetNewDoubleValue(newValue));}
+
+  if (command == fGammaFactorCmd)
+   {dose->SetConstant(CrossingRecord::kGamma,
+                      fGammaFactorCmd->GetNewDoubleValue(newValue));}
+
+  if (command == fSparseVoxelCmd)
+   {fHistoManager->SetSparseVoxelSize(fSparseVoxelCmd->GetNewDoubleValue(newValue));}
+
+  if (command == fPointCmd)
+   {fHistoManager->AddPointDetector(fPointCmd->GetNew3VectorValue(newValue));}
+
+  if (command == fClearPointsCmd)
+   {fHistoManager->ClearPointDetectors();}
+
+  if (command == fPointDistanceCmd)
+   {fHistoManager->SetPointMinDistance(fPointDistanceCmd->GetNewDoubleValue(newValue));}
+
+  if (command == fPointCacheCmd)
+   {fHistoManager->SetPointCacheCell(fPointCacheCmd->GetNewDoubleValue(newValue));}
+
+  if (command == fNeutronTableCmd) {
+    if (newValue == "icrp74") dose->UseICRP74(CrossingRecord::kNeutron);
+    else dose->LoadTable(CrossingRecord::kNeutron, newValue);
+  }
+
+  if (command == fGammaTableCmd) {
+    if (newValue == "icrp74") dose->UseICRP74(CrossingRecord::kGamma);
+    else dose->LoadTable(CrossingRecord::kGamma, newValue);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
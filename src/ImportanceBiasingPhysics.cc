@@ -0,0 +1,85 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file ImportanceBiasingPhysics.cc
+/// \brief Implementation of the ImportanceBiasingPhysics class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "ImportanceBiasingPhysics.hh"
+#include "ImportanceWorld.hh"
+
+#include "G4GeometrySampler.hh"
+#include "G4ImportanceBiasing.hh"
+#include "G4ParallelWorldPhysics.hh"
+#include "G4TransportationManager.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ImportanceBiasingPhysics::ImportanceBiasingPhysics(ImportanceWorld* world)
+  : G4VPhysicsConstructor("ImportanceBiasing"), fWorld(world),
+    fParallelWorld(0)
+{
+  // the samplers get the ghost world of their thread at ConstructProcess()
+  const G4String& worldName = fWorld->GetName();
+  const char* particle[kNbParticles] = { "neutron", "gamma" };
+  for (G4int i=0; i<kNbParticles; ++i) {
+    fSampler[i] = new G4GeometrySampler(0, particle[i]);
+    fSampler[i]->SetParallel(true);
+    fBiasing[i] = new G4ImportanceBiasing(fSampler[i], worldName);
+  }
+  fParallelWorld = new G4ParallelWorldPhysics(worldName);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ImportanceBiasingPhysics::~ImportanceBiasingPhysics()
+{
+  for (G4int i=0; i<kNbParticles; ++i) {
+    delete fBiasing[i];
+    delete fSampler[i];
+  }
+  delete fParallelWorld;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ImportanceBiasingPhysics::ConstructProcess()
+{
+  if (!fWorld->HasLayers()) return;
+
+  G4VPhysicalVolume* ghostWorld = G4TransportationManager::
+    GetTransportationManager()->GetParallelWorld(fWorld->GetName());
+  for (G4int i=0; i<kNbParticles; ++i) {
+    fSampler[i]->SetWorld(ghostWorld);
+    fBiasing[i]->ConstructProcess();
+  }
+  fParallelWorld->ConstructProcess();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
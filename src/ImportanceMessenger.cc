@@ -0,0 +1,125 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file ImportanceMessenger.cc
+/// \brief Implementation of the ImportanceMessenger class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "ImportanceMessenger.hh"
+
+#include "ImportanceWorld.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADouble.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ImportanceMessenger::ImportanceMessenger(ImportanceWorld* world)
+:G4UImessenger(), fWorld(world),
+ fBiasDir(0), fLayersCmd(0), fRatioCmd(0), fImportanceCmd(0), fPrintCmd(0)
+{
+  // the importances live in the (shared) parallel world: master only
+  G4bool broadcast = false;
+  fBiasDir = new G4UIdirectory("/testhadr/bias/",broadcast);
+  fBiasDir->SetGuidance("variance reduction commands");
+
+  fLayersCmd = new G4UIcmdWithAnInteger("/testhadr/bias/layers",this);
+  fLayersCmd->SetGuidance("Importance biasing: nb of layers across the tank");
+  fLayersCmd->SetGuidance("walls, from the chamber to the outer faces.");
+  fLayersCmd->SetGuidance("0 : no biasing (default)");
+  fLayersCmd->SetParameterName("nbLayers",false);
+  fLayersCmd->SetRange("nbLayers>=0");
+  fLayersCmd->AvailableForStates(G4State_PreInit);
+
+  fRatioCmd = new G4UIcmdWithADouble("/testhadr/bias/ratio",this);
+  fRatioCmd->SetGuidance("Importance ratio of adjacent layers (default 2):");
+  fRatioCmd->SetGuidance("resets the importance of cell k to ratio^k.");
+  fRatioCmd->SetParameterName("ratio",false);
+  fRatioCmd->SetRange("ratio>=1.");
+  fRatioCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fImportanceCmd = new G4UIcommand("/testhadr/bias/importance",this);
+  fImportanceCmd->SetGuidance("Set the importance of one cell:");
+  fImportanceCmd->SetGuidance("  0 = chamber, 1..N = layers, N+1 = outside tank");
+  //
+  G4UIparameter* cellPrm = new G4UIparameter("cell",'i',false);
+  cellPrm->SetGuidance("cell number");
+  cellPrm->SetParameterRange("cell>=0");
+  fImportanceCmd->SetParameter(cellPrm);
+  //
+  G4UIparameter* valuePrm = new G4UIparameter("importance",'d',false);
+  valuePrm->SetGuidance("importance of the cell");
+  valuePrm->SetParameterRange("importance>0.");
+  fImportanceCmd->SetParameter(valuePrm);
+  //
+  fImportanceCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fPrintCmd = new G4UIcmdWithoutParameter("/testhadr/bias/print",this);
+  fPrintCmd->SetGuidance("Print the importance of the cells.");
+  fPrintCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ImportanceMessenger::~ImportanceMessenger()
+{
+  delete fLayersCmd;
+  delete fRatioCmd;
+  delete fImportanceCmd;
+  delete fPrintCmd;
+  delete fBiasDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ImportanceMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fLayersCmd)
+   { fWorld->SetNbLayers(fLayersCmd->GetNewIntValue(newValue)); }
+
+  if (command == fRatioCmd)
+   { fWorld->SetRatio(fRatioCmd->GetNewDoubleValue(newValue)); }
+
+  if (command == fImportanceCmd)
+   {
+     G4int cell; G4double importance;
+     std::istringstream is(newValue);
+     is >> cell >> importance;
+     fWorld->SetImportance(cell, importance);
+   }
+
+  if (command == fPrintCmd)
+   { fWorld->Print(); }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
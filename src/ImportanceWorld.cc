@@ -0,0 +1,169 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file ImportanceWorld.cc
+/// \brief Implementation of the ImportanceWorld class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "ImportanceWorld.hh"
+#include "ImportanceMessenger.hh"
+#include "DetectorConstruction.hh"
+
+#include "G4Box.hh"
+#include "G4LogicalVolume.hh"
+#include "G4PVPlacement.hh"
+#include "G4IStore.hh"
+
+#include <cmath>
+#include <iomanip>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ImportanceWorld::ImportanceWorld(const G4String& worldName,
+                                 DetectorConstruction* det)
+  : G4VUserParallelWorld(worldName), fDetector(det), fMessenger(0),
+    fNbLayers(0), fRatio(2.)
+{
+  ResetImportances();
+  fMessenger = new ImportanceMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ImportanceWorld::~ImportanceWorld()
+{ delete fMessenger; }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ImportanceWorld::SetNbLayers(G4int n)
+{
+  fNbLayers = n;
+  ResetImportances();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ImportanceWorld::SetRatio(G4double ratio)
+{
+  fRatio = ratio;
+  ResetImportances();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ImportanceWorld::SetImportance(G4int cell, G4double importance)
+{
+  if (cell < 0 || cell >= GetNbCells()) {
+    G4cout << "\n--> warning from ImportanceWorld::SetImportance : cell "
+           << cell << " out of range [0," << GetNbCells()-1 << "]" << G4endl;
+    return;
+  }
+  fImportance[cell] = importance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ImportanceWorld::ResetImportances()
+{
+  // the particles leaving the tank keep the importance of the outer layer
+  fImportance.resize(GetNbCells());
+  for (G4int k=0; k<=fNbLayers; ++k) fImportance[k] = std::pow(fRatio, k);
+  fImportance[fNbLayers+1] = fImportance[fNbLayers];
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ImportanceWorld::Construct()
+{
+  if (!HasLayers()) return;
+
+  G4VPhysicalVolume* ghostWorld = GetWorld();
+  fCell.assign(GetNbCells(), 0);
+  fCell[fNbLayers+1] = ghostWorld;
+
+  // box k spans the chamber (k=0) to the tank (k=N), its lower and upper
+  // corners being interpolated linearly: the boxes are nested, and the
+  // shell between box k and box k-1 is layer k of the walls
+  G4ThreeVector chamberLow  = fDetector->GetChamberCenter()
+                            - 0.5*fDetector->GetChamberSize();
+  G4ThreeVector chamberHigh = fDetector->GetChamberCenter()
+                            + 0.5*fDetector->GetChamberSize();
+  G4ThreeVector tankLow  = fDetector->GetTankCenter() - 0.5*fDetector->GetTankSize();
+  G4ThreeVector tankHigh = fDetector->GetTankCenter() + 0.5*fDetector->GetTankSize();
+
+  G4LogicalVolume* motherL = ghostWorld->GetLogicalVolume();
+  G4ThreeVector motherCenter = G4ThreeVector();
+  for (G4int k=fNbLayers; k>=0; --k) {
+    G4double f = G4double(k)/fNbLayers;
+    G4ThreeVector low  = chamberLow  + f*(tankLow  - chamberLow);
+    G4ThreeVector high = chamberHigh + f*(tankHigh - chamberHigh);
+    G4ThreeVector half   = 0.5*(high - low);
+    G4ThreeVector center = 0.5*(high + low);
+
+    G4String name = "ImportanceCell" + std::to_string(k);
+    G4Box* cellS = new G4Box(name, half.x(), half.y(), half.z());
+    G4LogicalVolume* cellL = new G4LogicalVolume(cellS, 0, name);
+    fCell[k] = new G4PVPlacement(0, center - motherCenter, cellL, name,
+                                 motherL, false, 0);
+    motherL = cellL;
+    motherCenter = center;
+  }
+  Print();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ImportanceWorld::UpdateImportanceStore()
+{
+  if (!HasLayers()) return;
+
+  G4IStore* store = G4IStore::GetInstance(GetName());
+  for (G4int k=0; k<GetNbCells(); ++k) {
+    G4GeometryCell cell(*fCell[k], 0);
+    if (store->IsKnown(cell)) store->ChangeImportance(fImportance[k], *fCell[k]);
+    else                      store->AddImportanceGeometryCell(fImportance[k], *fCell[k]);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ImportanceWorld::Print() const
+{
+  G4cout << "\n Importance biasing across the tank walls: "
+         << fNbLayers << " layers" << G4endl;
+  for (G4int k=0; k<GetNbCells(); ++k) {
+    G4String name = "layer " + std::to_string(k);
+    if (k == 0)         name = "chamber";
+    if (k > fNbLayers)  name = "outside tank";
+    G4cout << "   cell " << std::setw(3) << k << "  " << std::setw(12) << name
+           << "  importance = " << fImportance[k] << G4endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,81 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file MeshSD.cc
+/// \brief Implementation of the MeshSD class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "MeshSD.hh"
+#include "MeshTally.hh"
+#include "CrossingBuffer.hh"
+
+#include "G4Step.hh"
+#include "G4Neutron.hh"
+#include "G4Gamma.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+MeshSD::MeshSD(const G4String& name)
+  : G4VSensitiveDetector(name), fTally(0),
+    fNeutron(G4Neutron::Definition()), fGamma(G4Gamma::Definition())
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+MeshSD::~MeshSD()
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool MeshSD::ProcessHits(G4Step* step, G4TouchableHistory*)
+{
+  if (!fTally) return false;
+
+  const G4ParticleDefinition* particle = step->GetTrack()->GetDefinition();
+  G4int particleCode;
+  if      (particle == fNeutron) particleCode = CrossingRecord::kNeutron;
+  else if (particle == fGamma)   particleCode = CrossingRecord::kGamma;
+  else return false;
+
+  G4double length = step->GetStepLength();
+  if (length <= 0.) return false;
+
+  // replica numbers of the voxel: z at depth 0, y at 1, x at 2
+  const G4StepPoint* pre = step->GetPreStepPoint();
+  const G4VTouchable* touchable = pre->GetTouchable();
+
+  fTally->Score(particleCode,
+                touchable->GetReplicaNumber(2),
+                touchable->GetReplicaNumber(1),
+                touchable->GetReplicaNumber(0),
+                pre->GetKineticEnergy(),
+                pre->GetWeight()*length);
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
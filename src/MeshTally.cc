@@ -0,0 +1,176 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file MeshTally.cc
+/// \brief Implementation of the MeshTally class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "MeshTally.hh"
+
+#include "G4SystemOfUnits.hh"
+#include "G4UnitsTable.hh"
+
+#include <fstream>
+#include <iomanip>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+MeshTally::MeshTally()
+  : fSourceRate(1.e8), fDose(0), fNx(0), fNy(0), fNz(0), fNbVoxels(0)
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+MeshTally::~MeshTally()
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void MeshTally::Book(const G4ThreeVector& origin,
+                     const G4ThreeVector& voxelSize,
+                     G4int nx, G4int ny, G4int nz)
+{
+  fOrigin    = origin;
+  fVoxelSize = voxelSize;
+  fNx = nx; fNy = ny; fNz = nz;
+  fNbVoxels = size_t(nx)*ny*nz;
+  fLength.assign(kNbParticles*fNbVoxels, 0.);
+  fDoseSum.assign(kNbParticles*fNbVoxels, 0.);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void MeshTally::Merge(const MeshTally& other)
+{
+  if (other.fNbVoxels != fNbVoxels) {
+    G4cout << "\n--> warning from MeshTally::Merge : "
+           << "mesh differs between threads, tally not merged" << G4endl;
+    return;
+  }
+  const G4double* length = other.fLength.data();
+  const G4double* dose   = other.fDoseSum.data();
+  for (size_t i=0; i<fLength.size(); ++i) {
+    fLength[i]  += length[i];
+    fDoseSum[i] += dose[i];
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double MeshTally::GetFluenceRate(G4int particle, size_t voxel,
+                                   G4int nbEvents) const
+{
+  if (nbEvents == 0) return 0.;
+  G4double volume = fVoxelSize.x()*fVoxelSize.y()*fVoxelSize.z()/cm3;
+  G4double length = fLength[particle*fNbVoxels + voxel]/cm;
+  return length/volume * fSourceRate/nbEvents;                  //cm-2 s-1
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double MeshTally::GetDoseRate(G4int particle, size_t voxel,
+                                G4int nbEvents) const
+{
+  if (nbEvents == 0) return 0.;
+  G4double volume = fVoxelSize.x()*fVoxelSize.y()*fVoxelSize.z()/cm3;
+  G4double dose   = fDoseSum[particle*fNbVoxels + voxel]/cm;    //pSv cm3
+  return dose/volume * fSourceRate/nbEvents * 3600. * 1.e-6;     //microSv/h
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void MeshTally::Print(G4int nbEvents) const
+{
+  if (!IsBooked() || nbEvents == 0) return;
+
+  const char* particleName[kNbParticles] = { "neutron", "gamma" };
+
+  G4int dfprec = G4cout.precision(4);
+  G4cout << "\n Dose-rate mesh of the room: " << fNx << " x " << fNy
+         << " x " << fNz << " voxels of "
+         << G4BestUnit(fVoxelSize,"Length") << G4endl;
+
+  for (G4int p=0; p<kNbParticles; ++p) {
+    G4double peak = 0.;
+    size_t voxelPeak = 0;
+    for (size_t i=0; i<fNbVoxels; ++i) {
+      G4double rate = GetDoseRate(p, i, nbEvents);
+      if (rate > peak) { peak = rate; voxelPeak = i; }
+    }
+    G4int iz = voxelPeak % fNz;
+    G4int iy = (voxelPeak/fNz) % fNy;
+    G4int ix = voxelPeak/(size_t(fNz)*fNy);
+    G4cout << "  " << std::setw(8) << particleName[p]
+           << ": peak = " << peak << " microSv/h in voxel ("
+           << ix << "," << iy << "," << iz << ")" << G4endl;
+  }
+  G4cout.precision(dfprec);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool MeshTally::Write(const G4String& fileName, G4int nbEvents) const
+{
+  if (!IsBooked()) return false;
+
+  std::ofstream file(fileName);
+  if (!file) {
+    G4cout << "\n--> warning from MeshTally::Write : cannot open "
+           << fileName << G4endl;
+    return false;
+  }
+
+  file << "# dose-rate mesh of the room\n"
+       << "# voxels: " << fNx << " " << fNy << " " << fNz << "\n"
+       << "# origin [cm]: " << fOrigin.x()/cm << " " << fOrigin.y()/cm
+       << " " << fOrigin.z()/cm << "\n"
+       << "# voxel size [cm]: " << fVoxelSize.x()/cm << " "
+       << fVoxelSize.y()/cm << " " << fVoxelSize.z()/cm << "\n"
+       << "# source: " << fSourceRate << " primaries/s, "
+       << nbEvents << " events\n"
+       << "# ix,iy,iz,nFluence[cm-2 s-1],gFluence[cm-2 s-1],"
+       << "nDose[microSv/h],gDose[microSv/h]\n";
+
+  // only the voxels crossed by a neutron or a gamma
+  size_t voxel = 0;
+  for (G4int ix=0; ix<fNx; ++ix) {
+    for (G4int iy=0; iy<fNy; ++iy) {
+      for (G4int iz=0; iz<fNz; ++iz, ++voxel) {
+        if (fLength[voxel] == 0. && fLength[fNbVoxels+voxel] == 0.) continue;
+        file << ix << "," << iy << "," << iz << ","
+             << GetFluenceRate(0, voxel, nbEvents) << ","
+             << GetFluenceRate(1, voxel, nbEvents) << ","
+             << GetDoseRate(0, voxel, nbEvents) << ","
+             << GetDoseRate(1, voxel, nbEvents) << "\n";
+      }
+    }
+  }
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
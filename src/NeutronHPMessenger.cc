@@ -36,12 +36,14 @@
 
 #include "G4UIdirectory.hh"
 #include "G4UIcmdWithABool.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 NeutronHPMessenger::NeutronHPMessenger(NeutronHPphysics* phys)
 :G4UImessenger(),fNeutronPhysics(phys),
- fPhysDir(0), fThermalCmd(0)
+ fPhysDir(0), fThermalCmd(0), fImplicitCmd(0), fCutoffCmd(0), fCaptureBiasCmd(0)
 { 
   fPhysDir = new G4UIdirectory("/testhadr/phys/");
   fPhysDir->SetGuidance("physics list commands");
@@ -50,6 +52,53 @@ NeutronHPMessenger::NeutronHPMessenger(NeutronHPphysics* phys)
   fThermalCmd->SetGuidance("set thermal scattering model");
   fThermalCmd->SetParameterName("thermal",false);
   fThermalCmd->AvailableForStates(G4State_PreInit);  
+
+  fImplicitCmd = new G4UIcommand("/testhadr/phys/implicitCapture",this);
+  fImplicitCmd->SetGuidance("Implicit capture of the neutrons in a volume:");
+  fImplicitCmd->SetGuidance("no absorption, the weight is reduced instead by");
+  fImplicitCmd->SetGuidance("the probability to survive the capture.");
+  fImplicitCmd->SetGuidance("volume: logical volume name (Tank, Chamber, Room...)");
+  //
+  G4UIparameter* volumePrm = new G4UIparameter("volume",'s',false);
+  fImplicitCmd->SetParameter(volumePrm);
+  //
+  G4UIparameter* flagPrm = new G4UIparameter("flag",'b',true);
+  flagPrm->SetDefaultValue("true");
+  fImplicitCmd->SetParameter(flagPrm);
+  //
+  fImplicitCmd->AvailableForStates(G4State_PreInit);
+
+  fCutoffCmd = new G4UIcommand("/testhadr/phys/weightCutoff",this);
+  fCutoffCmd->SetGuidance("Russian roulette of the neutrons under implicit");
+  fCutoffCmd->SetGuidance("capture below the weight cutoff; the survivors");
+  fCutoffCmd->SetGuidance("get the survival weight (default 0.25 0.5)");
+  //
+  G4UIparameter* cutoffPrm = new G4UIparameter("cutoff",'d',false);
+  cutoffPrm->SetParameterRange("cutoff>0.");
+  fCutoffCmd->SetParameter(cutoffPrm);
+  //
+  G4UIparameter* survivalPrm = new G4UIparameter("survival",'d',false);
+  survivalPrm->SetParameterRange("survival>0.");
+  fCutoffCmd->SetParameter(survivalPrm);
+  //
+  fCutoffCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fCaptureBiasCmd = new G4UIcommand("/testhadr/phys/captureBias",this);
+  fCaptureBiasCmd->SetGuidance("Multiply the neutron capture cross section in a");
+  fCaptureBiasCmd->SetGuidance("material by a factor, the weights corrected.");
+  fCaptureBiasCmd->SetGuidance("Captures happen earlier along the path; where");
+  fCaptureBiasCmd->SetGuidance("the neutrons are captured anyway, this gives");
+  fCaptureBiasCmd->SetGuidance("no more capture gammas.");
+  fCaptureBiasCmd->SetGuidance("factor 1 : analog (default)");
+  //
+  G4UIparameter* materialPrm = new G4UIparameter("material",'s',false);
+  fCaptureBiasCmd->SetParameter(materialPrm);
+  //
+  G4UIparameter* factorPrm = new G4UIparameter("factor",'d',false);
+  factorPrm->SetParameterRange("factor>0.");
+  fCaptureBiasCmd->SetParameter(factorPrm);
+  //
+  fCaptureBiasCmd->AvailableForStates(G4State_PreInit);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -57,6 +106,9 @@ NeutronHPMessenger::NeutronHPMessenger(NeutronHPphysics* phys)
 NeutronHPMessenger::~NeutronHPMessenger()
 {
   delete fThermalCmd;
+  delete fImplicitCmd;
+  delete fCutoffCmd;
+  delete fCaptureBiasCmd;
   delete fPhysDir;
 }
 
@@ -66,6 +118,36 @@ void NeutronHPMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
 {   
   if (command == fThermalCmd)
    {fNeutronPhysics->SetThermalPhysics(fThermalCmd->GetNewBoolValue(newValue));}
+
+  if (command == fImplicitCmd)
+   {
+     G4String volume, flag;
+     std::istringstream is(newValue);
+     is >> volume >> flag;
+     fNeutronPhysics->SetImplicitCapture(volume, G4UIcommand::ConvertToBool(flag));
+   }
+
+  if (command == fCutoffCmd)
+   {
+     G4double cutoff, survival;
+     std::istringstream is(newValue);
+     is >> cutoff >> survival;
+     if (survival < cutoff) {
+       G4cout << "\n--> warning from NeutronHPMessenger : "
+              << "survival weight below the cutoff, set to the cutoff" << G4endl;
+       survival = cutoff;
+     }
+     fNeutronPhysics->SetWeightCutoff(cutoff, survival);
+   }
+
+  if (command == fCaptureBiasCmd)
+   {
+     G4String material;
+     G4double factor;
+     std::istringstream is(newValue);
+     is >> material >> factor;
+     fNeutronPhysics->SetCaptureBias(material, factor);
+   }
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
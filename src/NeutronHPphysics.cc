@@ -33,10 +33,14 @@
 #include "NeutronHPphysics.hh"
 
 #include "NeutronHPMessenger.hh"
+#include "CaptureBiasingOperator.hh"
 
 #include "G4ParticleDefinition.hh"
 #include "G4ProcessManager.hh"
 #include "G4ProcessTable.hh"
+#include "G4BiasingHelper.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Material.hh"
 
 // Processes
 
@@ -63,7 +67,8 @@
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 NeutronHPphysics::NeutronHPphysics(const G4String& name)
-:  G4VPhysicsConstructor(name), fThermal(true), fNeutronMessenger(0)
+:  G4VPhysicsConstructor(name), fThermal(true), fNeutronMessenger(0),
+   fWeightCutoff(0.25), fSurvivalWeight(0.5)
 {
   fNeutronMessenger = new NeutronHPMessenger(this);
 }
@@ -140,6 +145,12 @@ void NeutronHPphysics::ConstructProcess()
   // models
   G4ParticleHPCapture* model3 = new G4ParticleHPCapture();
   process3->RegisterMe(model3);
+  //
+  // biased capture, by a thread-local operator
+  if (HasCaptureBiasing()) {
+    G4BiasingHelper::ActivatePhysicsBiasing(pManager, "nCapture");
+    new CaptureBiasingOperator(this);
+  }
    
   // (re) create process: nFission   
   //
@@ -156,3 +167,33 @@ void NeutronHPphysics::ConstructProcess()
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void NeutronHPphysics::SetImplicitCapture(const G4String& volume, G4bool flag)
+{
+  if (flag) fCaptureFactor[volume] = 0.;
+  else      fCaptureFactor.erase(volume);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void NeutronHPphysics::SetCaptureBias(const G4String& material, G4double factor)
+{
+  if (factor != 1.) fMaterialFactor[material] = factor;
+  else              fMaterialFactor.erase(material);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double NeutronHPphysics::GetCaptureFactor(const G4LogicalVolume* volume) const
+{
+  std::map<G4String, G4double>::const_iterator it
+    = fCaptureFactor.find(volume->GetName());
+  if (it != fCaptureFactor.end()) return it->second;
+
+  const G4Material* material = volume->GetMaterial();
+  if (!material) return 1.;
+  it = fMaterialFactor.find(material->GetName());
+  return (it != fMaterialFactor.end()) ? it->second : 1.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
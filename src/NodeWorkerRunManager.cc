@@ -0,0 +1,126 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file NodeWorkerRunManager.cc
+/// \brief Implementation of the NodeMerger and NodeWorkerRunManager classes
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "NodeWorkerRunManager.hh"
+
+#ifdef G4MULTITHREADED
+
+#include "ThreadAffinity.hh"
+#include "ChunkedRunManager.hh"
+
+#include "G4MTRunManager.hh"
+#include "G4Run.hh"
+#include "G4ScoringManager.hh"
+#include "G4Threading.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+NodeMerger::NodeMerger(const ThreadAffinity* affinity)
+  : fAffinity(affinity), fNodes(affinity->GetNbNodes())
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+NodeMerger::~NodeMerger()
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const G4Run* NodeMerger::Merge(G4Run* run, G4int thread, G4int nbThreads)
+{
+  G4int node = fAffinity->GetNode(thread);
+  G4int nbOfNode = 0;
+  for (G4int i=0; i<nbThreads; ++i) {
+    if (fAffinity->GetNode(i) == node) ++nbOfNode;
+  }
+
+  Node& sum = fNodes[node];
+  std::lock_guard<std::mutex> lock(sum.mutex);
+  if (sum.nbMerged == 0) sum.sum = run;
+  else                   sum.sum->Merge(run);
+  if (++sum.nbMerged < nbOfNode) return 0;
+
+  // last of the node: ready for the next run
+  sum.nbMerged = 0;
+  return sum.sum;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+NodeWorkerRunManager::NodeWorkerRunManager(NodeMerger* merger)
+  : G4WorkerRunManager(), fMerger(merger)
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+NodeWorkerRunManager::~NodeWorkerRunManager()
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#if G4VERSION_NUMBER >= 1120
+void NodeWorkerRunManager::MergePartialResults(G4bool mergeEvents)
+#else
+void NodeWorkerRunManager::MergePartialResults()
+#endif
+{
+  G4MTRunManager* master = G4MTRunManager::GetMasterRunManager();
+  ChunkedRunManager* timer = dynamic_cast<ChunkedRunManager*>(master);
+  if (timer) timer->BeginMerge();
+  if (fMerger) MergeThroughNode(master);
+#if G4VERSION_NUMBER >= 1120
+  else         G4WorkerRunManager::MergePartialResults(mergeEvents);
+#else
+  else         G4WorkerRunManager::MergePartialResults();
+#endif
+  if (timer) timer->EndMerge();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void NodeWorkerRunManager::MergeThroughNode(G4MTRunManager* master)
+{
+  // command-based scorers, as G4WorkerRunManager
+  G4ScoringManager* scoring = G4ScoringManager::GetScoringManagerIfExist();
+  if (scoring) master->MergeScores(scoring);
+
+  // the run: through the sum of the node
+  if (!currentRun) return;
+  const G4Run* nodeRun = fMerger->Merge(currentRun, G4Threading::G4GetThreadId(),
+                                        master->GetNumberOfThreads());
+  if (nodeRun) master->MergeRun(nodeRun);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
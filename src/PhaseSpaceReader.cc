@@ -0,0 +1,154 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file PhaseSpaceReader.cc
+/// \brief Implementation of the PhaseSpaceReader class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "PhaseSpaceReader.hh"
+
+#include <cstring>
+
+namespace {
+  const size_t kBlockSize = 4096;   // records read at once
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhaseSpaceReader* PhaseSpaceReader::Instance()
+{
+  static PhaseSpaceReader instance;
+  return &instance;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhaseSpaceReader::PhaseSpaceReader()
+  : fFile(0), fBlock(kBlockSize), fNext(0), fSize(0), fNbRead(0), fNbPasses(0)
+{
+  std::memset(&fHeader, 0, sizeof(fHeader));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhaseSpaceReader::~PhaseSpaceReader()
+{
+  if (fFile) std::fclose(fFile);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PhaseSpaceReader::Open(const G4String& fileName)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  if (fFile && fileName == fFileName) return true;
+  if (fFile) std::fclose(fFile);
+  fFile = 0;
+  std::memset(&fHeader, 0, sizeof(fHeader));
+
+  std::FILE* file = std::fopen(fileName.c_str(), "rb");
+  if (!file) {
+    G4cout << "\n--> warning from PhaseSpaceReader::Open : cannot open "
+           << fileName << G4endl;
+    return false;
+  }
+  PhaseSpaceFormat::FileHeader header;
+  if (std::fread(&header, sizeof(header), 1, file) != 1
+      || std::memcmp(header.magic, PhaseSpaceFormat::kMagic,
+                     sizeof(header.magic)) != 0
+      || header.version != PhaseSpaceFormat::kVersion
+      || header.recordSize != sizeof(PhaseSpaceFormat::Record)) {
+    G4cout << "\n--> warning from PhaseSpaceReader::Open : " << fileName
+           << " is not a phase-space file of this version" << G4endl;
+    std::fclose(file);
+    return false;
+  }
+  if (header.nbRecords == 0 || header.nbPrimaries <= 0.) {
+    G4cout << "\n--> warning from PhaseSpaceReader::Open : " << fileName
+           << " holds no particle, or its run did not end" << G4endl;
+    std::fclose(file);
+    return false;
+  }
+
+  fFile     = file;
+  fFileName = fileName;
+  fHeader   = header;
+  fNext = fSize = 0;
+  fNbRead   = 0;
+  fNbPasses = 0;
+
+  G4cout << "\n Phase space " << fileName << " : " << header.nbRecords
+         << " particles from " << header.nbPrimaries << " primaries" << G4endl;
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhaseSpaceReader::Close()
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  if (fFile) std::fclose(fFile);
+  fFile = 0;
+  fFileName = "";
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PhaseSpaceReader::ReadBlock()
+{
+  // the records of the header count only: a file cut short ends there
+  if (fNbRead == fHeader.nbRecords) {
+    std::fseek(fFile, sizeof(PhaseSpaceFormat::FileHeader), SEEK_SET);
+    fNbRead = 0;
+    if (++fNbPasses == 1) {
+      G4cout << "\n--> warning from PhaseSpaceReader : " << fFileName
+             << " exhausted, its records are used again" << G4endl;
+    }
+  }
+  uint64_t left = fHeader.nbRecords - fNbRead;
+  size_t   n    = (left < fBlock.size()) ? size_t(left) : fBlock.size();
+  fSize = std::fread(fBlock.data(), sizeof(PhaseSpaceFormat::Record), n, fFile);
+  fNext = 0;
+  if (fSize < n) fHeader.nbRecords = fNbRead + fSize;
+  fNbRead += fSize;
+  return fSize > 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PhaseSpaceReader::Next(PhaseSpaceFormat::Record& record)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  if (!fFile) return false;
+  if (fNext == fSize && !ReadBlock() && !ReadBlock()) return false;
+  record = fBlock[fNext++];
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
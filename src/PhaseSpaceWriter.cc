@@ -0,0 +1,146 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file PhaseSpaceWriter.cc
+/// \brief Implementation of the PhaseSpaceWriter and PhaseSpaceBuffer classes
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "PhaseSpaceWriter.hh"
+
+#include <cstring>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhaseSpaceWriter* PhaseSpaceWriter::Instance(Stream stream)
+{
+  static PhaseSpaceWriter tankExit("Phase space of the tank", kTankExit);
+  static PhaseSpaceWriter gammaSource("Gamma source of the neutron phase",
+                                      kGammaSource);
+  return (stream == kGammaSource) ? &gammaSource : &tankExit;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhaseSpaceWriter::PhaseSpaceWriter(const G4String& description, Stream stream)
+  : fDescription(description), fStream(stream), fFile(0), fNbRecords(0)
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhaseSpaceWriter::~PhaseSpaceWriter()
+{
+  if (fFile) std::fclose(fFile);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhaseSpaceWriter::Open(const G4String& fileName)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  if (fFile) std::fclose(fFile);
+
+  fFile = std::fopen(fileName.c_str(), "wb");
+  if (!fFile) {
+    G4cout << "\n--> warning from PhaseSpaceWriter::Open : cannot open "
+           << fileName << G4endl;
+    return;
+  }
+  fFileName  = fileName;
+  fNbRecords = 0;
+
+  // the counts are filled in by Close()
+  PhaseSpaceFormat::FileHeader header;
+  std::memcpy(header.magic, PhaseSpaceFormat::kMagic, sizeof(header.magic));
+  header.version     = PhaseSpaceFormat::kVersion;
+  header.recordSize  = sizeof(PhaseSpaceFormat::Record);
+  header.nbRecords   = 0;
+  header.nbPrimaries = 0.;
+  header.source      = (fStream == kGammaSource) ? PhaseSpaceFormat::kGammaSource
+                                                 : PhaseSpaceFormat::kTankExit;
+  header.reserved    = 0;
+  std::fwrite(&header, sizeof(header), 1, fFile);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhaseSpaceWriter::Write(const PhaseSpaceFormat::Record* records, size_t n)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  if (!fFile) return;
+  fNbRecords += std::fwrite(records, sizeof(PhaseSpaceFormat::Record), n, fFile);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhaseSpaceWriter::Close(G4double nbPrimaries)
+{
+  std::lock_guard<std::mutex> lock(fMutex);
+  if (!fFile) return;
+
+  PhaseSpaceFormat::FileHeader header;
+  std::memcpy(header.magic, PhaseSpaceFormat::kMagic, sizeof(header.magic));
+  header.version     = PhaseSpaceFormat::kVersion;
+  header.recordSize  = sizeof(PhaseSpaceFormat::Record);
+  header.nbRecords   = fNbRecords;
+  header.nbPrimaries = nbPrimaries;
+  header.source      = (fStream == kGammaSource) ? PhaseSpaceFormat::kGammaSource
+                                                 : PhaseSpaceFormat::kTankExit;
+  header.reserved    = 0;
+  std::fseek(fFile, 0, SEEK_SET);
+  std::fwrite(&header, sizeof(header), 1, fFile);
+  std::fclose(fFile);
+  fFile = 0;
+
+  G4cout << "\n " << fDescription << " written to " << fFileName << " : "
+         << fNbRecords << " particles from " << nbPrimaries << " primaries"
+         << G4endl;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhaseSpaceBuffer::PhaseSpaceBuffer(PhaseSpaceWriter::Stream stream,
+                                   size_t capacity)
+  : fWriter(PhaseSpaceWriter::Instance(stream)), fRecords(capacity), fSize(0)
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PhaseSpaceBuffer::~PhaseSpaceBuffer()
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PhaseSpaceBuffer::Flush()
+{
+  if (fSize == 0) return;
+  fWriter->Write(fRecords.data(), fSize);
+  fSize = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
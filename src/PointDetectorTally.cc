@@ -0,0 +1,137 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file PointDetectorTally.cc
+/// \brief Implementation of the PointDetectorTally class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "PointDetectorTally.hh"
+
+#include "G4SystemOfUnits.hh"
+#include "G4UnitsTable.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PointDetectorTally::PointDetectorTally()
+  : fSourceRate(1.e8), fDose(0), fEventScored(false)
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PointDetectorTally::~PointDetectorTally()
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PointDetectorTally::Book(const std::vector<G4ThreeVector>& points)
+{
+  fPoint = points;
+  size_t n = fPoint.size()*kNbParticles;
+  fEventSum.assign(n, 0.);
+  fSum1.assign(n, 0.);
+  fSum2.assign(n, 0.);
+  fEventScored = false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PointDetectorTally::EndOfEvent()
+{
+  if (!fEventScored) return;
+  for (size_t i=0; i<fEventSum.size(); ++i) {
+    G4double x = fEventSum[i];
+    if (x == 0.) continue;
+    fSum1[i] += x;
+    fSum2[i] += x*x;
+    fEventSum[i] = 0.;
+  }
+  fEventScored = false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PointDetectorTally::Merge(const PointDetectorTally& other)
+{
+  if (other.fSum1.size() != fSum1.size()) {
+    G4cout << "\n--> warning from PointDetectorTally::Merge : "
+           << "points differ between threads, tally not merged" << G4endl;
+    return;
+  }
+  for (size_t i=0; i<fSum1.size(); ++i) {
+    fSum1[i] += other.fSum1[i];
+    fSum2[i] += other.fSum2[i];
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double PointDetectorTally::GetDoseRate(G4int point, G4int particle,
+                                         G4int nbEvents) const
+{
+  if (nbEvents == 0) return 0.;
+  // pSv per primary -> microSv/h at the source rate
+  return fSum1[point*kNbParticles + particle]*fSourceRate/nbEvents
+         * 3600. * 1.e-6;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PointDetectorTally::Print(G4int nbEvents, G4double time) const
+{
+  if (!IsBooked() || nbEvents == 0) return;
+
+  const char* particleName[kNbParticles] = { "neutron", "gamma" };
+
+  // R^2 = sum x^2/(sum x)^2 - 1/N for the per-event doses x of a point
+  G4int dfprec = G4cout.precision(4);
+  G4cout << "\n Dose rate at the point detectors (microSv/h, "
+         << fSourceRate << " primaries/s; " << nbEvents
+         << " events in " << time << " s)" << G4endl;
+  for (G4int i=0; i<GetNbPoints(); ++i) {
+    G4cout << "  point " << i << " at " << G4BestUnit(fPoint[i],"Length")
+           << G4endl;
+    for (G4int p=0; p<kNbParticles; ++p) {
+      G4double sum1 = fSum1[i*kNbParticles + p], sum2 = fSum2[i*kNbParticles + p];
+      G4cout << "  " << std::setw(10) << particleName[p] << ": ";
+      if (sum1 <= 0.) { G4cout << "no score" << G4endl; continue; }
+      G4double r2 = std::max(sum2/(sum1*sum1) - 1./nbEvents, 0.);
+      G4cout << std::setw(10) << GetDoseRate(i, p, nbEvents)
+             << "  R = " << std::setw(10) << std::sqrt(r2);
+      if (r2 > 0. && time > 0.) G4cout << "  FOM = " << 1./(r2*time) << " /s";
+      G4cout << G4endl;
+    }
+  }
+  G4cout.precision(dfprec);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
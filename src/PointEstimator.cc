@@ -0,0 +1,362 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file PointEstimator.cc
+/// \brief Implementation of the PointEstimator class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "PointEstimator.hh"
+#include "PointDetectorTally.hh"
+#include "CrossingBuffer.hh"
+
+#include "G4BiasingProcessInterface.hh"
+#include "G4EmCalculator.hh"
+#include "G4EmProcessSubType.hh"
+#include "G4HadronicProcess.hh"
+#include "G4HadronicProcessStore.hh"
+#include "G4HadronicProcessType.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Material.hh"
+#include "G4Navigator.hh"
+#include "G4Neutron.hh"
+#include "G4Nucleus.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Threading.hh"
+#include "G4UnitsTable.hh"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace {
+  // rays more opaque than this are not worth the exponential
+  const G4double kMaxTau    = 50.;
+  // paths cached per point before the cache of the point is dropped
+  const size_t   kMaxCached = 1 << 18;
+  // log-energy grid of the cross sections, 10 nodes per decade
+  const G4double kEmin[2]   = { 1.e-5*eV, 1.*keV };     // neutron, gamma
+  const G4double kEmax[2]   = { 20.*MeV, 20.*MeV };
+  const G4double kPerDecade = 10.;
+  // below, the elastic scattering of neutrons is taken isotropic
+  const G4double kThermalCutoff = 4.*eV;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PointEstimator::PointEstimator()
+  : fNavigator(0), fTally(0), fMinDistance(1.*cm), fCacheCell(0.),
+    fNbTraced(0.), fNbCached(0.), fNbScored(0.), fNbIsotropic(0.)
+{
+  fNavigator = new G4Navigator();
+  for (G4int p=0; p<kNbParticles; ++p) {
+    fLogEmin[p] = std::log(kEmin[p]);
+    fInvStep[p] = kPerDecade/std::log(10.);
+    fNbNodes[p] = G4int(std::ceil((std::log(kEmax[p]) - fLogEmin[p])*fInvStep[p])) + 1;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PointEstimator::~PointEstimator()
+{
+  delete fNavigator;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PointEstimator::BeginOfRun(G4VPhysicalVolume* world,
+                                PointDetectorTally* tally,
+                                G4double minDistance, G4double cacheCell)
+{
+  fTally       = tally;
+  fMinDistance = minDistance;
+  fCacheCell   = cacheCell;
+  fNbTraced = fNbCached = 0.;
+  fNbScored = fNbIsotropic = 0.;
+
+  // the geometry may have been rebuilt since the previous run
+  fNavigator->SetWorldVolume(world);
+  fCache.assign(tally->GetNbPoints(), std::unordered_map<uint64_t, Path>());
+
+  if (!G4Threading::IsMasterThread()) return;
+  for (G4int i=0; i<tally->GetNbPoints(); ++i) {
+    if (!fNavigator->LocateGlobalPointAndSetup(tally->GetPoint(i), 0, false, true)) {
+      G4cout << "\n--> warning from PointEstimator::BeginOfRun : point "
+             << G4BestUnit(tally->GetPoint(i),"Length")
+             << " is outside the world" << G4endl;
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PointEstimator::ScoreEmission(G4int particle, const G4VProcess* creator,
+                                   const G4ThreeVector& position,
+                                   G4double energy, G4double weight)
+{
+  fNbScored++;
+  if (creator && creator->GetProcessType() == fElectromagnetic
+      && creator->GetProcessSubType() == fBremsstrahlung) fNbIsotropic++;
+
+  for (G4int i=0; i<fTally->GetNbPoints(); ++i) {
+    G4double distance = (fTally->GetPoint(i) - position).mag();
+    G4double attenuation = Attenuation(i, particle, position, distance, energy);
+    if (attenuation <= 0.) continue;
+    G4double r = std::max(distance, fMinDistance)/cm;
+    fTally->Score(i, particle, weight*attenuation/(4*pi*r*r), energy);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PointEstimator::ScoreCollision(G4int particle, const G4VProcess* process,
+                                    const G4ThreeVector& position,
+                                    const G4ThreeVector& direction,
+                                    G4double energy, G4double weight)
+{
+  // the law of the process, behind its biasing wrapper if any
+  const G4BiasingProcessInterface* wrapper
+    = dynamic_cast<const G4BiasingProcessInterface*>(process);
+  if (wrapper) process = wrapper->GetWrappedProcess();
+  G4ProcessType type = process->GetProcessType();
+  if (type != fHadronic && type != fElectromagnetic) return;
+
+  Law law = kIsotropic;
+  G4double targetA = 1.;
+  G4int subType = process->GetProcessSubType();
+  if (type == fHadronic && subType == fHadronElastic && energy >= kThermalCutoff) {
+    const G4Nucleus* nucleus
+      = static_cast<const G4HadronicProcess*>(process)->GetTargetNucleus();
+    if (nucleus->GetA_asInt() > 0) {
+      law = kElastic;
+      targetA = nucleus->GetA_asInt();
+    }
+  }
+  else if (type == fElectromagnetic) {
+    if      (subType == fComptonScattering) law = kCompton;
+    else if (subType == fRayleigh)          law = kRayleigh;
+  }
+  fNbScored++;
+  if (law == kIsotropic) fNbIsotropic++;
+
+  for (G4int i=0; i<fTally->GetNbPoints(); ++i) {
+    G4ThreeVector toPoint = fTally->GetPoint(i) - position;
+    G4double distance = toPoint.mag();
+    G4double mu = (distance > 0.) ? direction.dot(toPoint)/distance : 1.;
+    G4double outEnergy;
+    G4double pdf = Scatter(law, energy, targetA, mu, outEnergy);
+    if (pdf <= 0.) continue;
+    G4double attenuation = Attenuation(i, particle, position, distance, outEnergy);
+    if (attenuation <= 0.) continue;
+    G4double r = std::max(distance, fMinDistance)/cm;
+    fTally->Score(i, particle, weight*pdf*attenuation/(2*pi*r*r), outEnergy);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double PointEstimator::Scatter(Law law, G4double energy, G4double targetA,
+                                 G4double mu, G4double& outEnergy)
+{
+  outEnergy = energy;
+  switch (law) {
+    case kElastic: {
+      // isotropic in the centre of mass: mu_cm from the lab mu, one to one
+      // for A > 1, forward only for hydrogen
+      G4double A = targetA;
+      if (A <= 1. && mu <= 0.) return 0.;
+      G4double q = std::sqrt(A*A - 1. + mu*mu);
+      G4double muCM = (mu*mu - 1. + mu*q)/A;
+      outEnergy = energy*(A*A + 2.*A*muCM + 1.)/((A + 1.)*(A + 1.));
+      return 0.5*(mu + q)*(mu + q)/(A*q);
+    }
+    case kCompton: {
+      G4double k = energy/electron_mass_c2;
+      G4double ratio = 1./(1. + k*(1. - mu));
+      outEnergy = energy*ratio;
+      return ratio*ratio*(ratio + 1./ratio - 1. + mu*mu)/KleinNishina(k);
+    }
+    case kRayleigh:
+      return 0.375*(1. + mu*mu);
+    default:
+      return 0.5;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double PointEstimator::KleinNishina(G4double k)
+{
+  // total Klein-Nishina cross section in units of pi r_e^2, k = E/mc^2
+  if (k < 1.e-3) return (8./3.)*(1. - 2.*k + 5.2*k*k);
+  G4double l = std::log(1. + 2.*k);
+  return 2.*((1. + k)/(k*k)*(2.*(1. + k)/(1. + 2.*k) - l/k)
+             + 0.5*l/k - (1. + 3.*k)/((1. + 2.*k)*(1. + 2.*k)));
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double PointEstimator::Attenuation(G4int point, G4int particle,
+                                     const G4ThreeVector& position,
+                                     G4double distance, G4double energy)
+{
+  // a cached path starts at the cell centre: its lengths are scaled to
+  // the actual distance
+  const Path& path = GetPath(point, position);
+  G4double tau = 0., length = 0.;
+  for (size_t k=0; k<path.size() && tau < kMaxTau; ++k) {
+    tau    += path[k].length*GetCrossSection(particle, path[k].material, energy);
+    length += path[k].length;
+  }
+  if (length > 0.) tau *= distance/length;
+  return (tau < kMaxTau) ? std::exp(-tau) : 0.;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const PointEstimator::Path& PointEstimator::GetPath(G4int point,
+                                                    const G4ThreeVector& from)
+{
+  // near the point the direction changes too fast across a cell
+  const G4ThreeVector& to = fTally->GetPoint(point);
+  if (fCacheCell <= 0. || (to - from).mag() < 4*fCacheCell) {
+    Trace(from, to, fScratch);
+    fNbTraced++;
+    return fScratch;
+  }
+
+  // 21 bits per cell index, offset to keep them positive
+  const G4int offset = 1 << 20;
+  uint64_t key = 0;
+  G4int index[3];
+  for (G4int i=0; i<3; ++i) {
+    index[i] = G4int(std::floor(from[i]/fCacheCell));
+    key = (key << 21) | (uint64_t(index[i] + offset) & 0x1FFFFF);
+  }
+
+  std::unordered_map<uint64_t, Path>& cache = fCache[point];
+  std::unordered_map<uint64_t, Path>::const_iterator it = cache.find(key);
+  if (it != cache.end()) {
+    fNbCached++;
+    return it->second;
+  }
+  if (cache.size() >= kMaxCached) cache.clear();
+
+  G4ThreeVector center((index[0] + 0.5)*fCacheCell, (index[1] + 0.5)*fCacheCell,
+                       (index[2] + 0.5)*fCacheCell);
+  Path& path = cache[key];
+  Trace(center, to, path);
+  fNbTraced++;
+  return path;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PointEstimator::Trace(const G4ThreeVector& from, const G4ThreeVector& to,
+                           Path& path)
+{
+  path.clear();
+  G4ThreeVector direction = to - from;
+  G4double length = direction.mag();
+  if (length <= 0.) return;
+  direction /= length;
+
+  // step from boundary to boundary of the mass geometry; consecutive
+  // volumes of the same material make one segment
+  G4double travelled = 0., safety;
+  G4VPhysicalVolume* volume
+    = fNavigator->LocateGlobalPointAndSetup(from, &direction, false, false);
+  for (G4int nbSteps=0; volume && travelled < length && nbSteps < 10000; ++nbSteps) {
+    G4double step = fNavigator->ComputeStep(from + travelled*direction,
+                                            direction, length - travelled,
+                                            safety);
+    step = std::min(std::max(step, 1.e-6*mm), length - travelled);
+    const G4Material* material = volume->GetLogicalVolume()->GetMaterial();
+    if (!path.empty() && path.back().material == material) {
+      path.back().length += step;
+    } else {
+      Segment segment = { material, step };
+      path.push_back(segment);
+    }
+    travelled += step;
+    fNavigator->SetGeometricallyLimitedStep();
+    volume = fNavigator->LocateGlobalPointAndSetup(from + travelled*direction,
+                                                   &direction, true);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double PointEstimator::GetCrossSection(G4int particle,
+                                         const G4Material* material,
+                                         G4double energy)
+{
+  std::map<const G4Material*, std::vector<G4double> >::iterator it
+    = fTable[particle].find(material);
+  if (it == fTable[particle].end()) {
+    it = fTable[particle].insert(std::make_pair(material,
+                                                std::vector<G4double>())).first;
+    BuildTable(particle, material, it->second);
+  }
+
+  // linear in log(E) between nodes; constant outside the grid
+  const std::vector<G4double>& sigma = it->second;
+  G4double u = (std::log(energy) - fLogEmin[particle])*fInvStep[particle];
+  u = std::min(std::max(u, 0.), G4double(fNbNodes[particle] - 1));
+  G4int node = std::min(G4int(u), fNbNodes[particle] - 2);
+  G4double f = u - node;
+  return (1. - f)*sigma[node] + f*sigma[node+1];
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PointEstimator::BuildTable(G4int particle, const G4Material* material,
+                                std::vector<G4double>& sigma)
+{
+  sigma.resize(fNbNodes[particle]);
+  G4HadronicProcessStore* store = G4HadronicProcessStore::Instance();
+  const G4ParticleDefinition* neutron = G4Neutron::Definition();
+  G4EmCalculator calculator;
+
+  for (G4int k=0; k<fNbNodes[particle]; ++k) {
+    G4double energy = std::exp(fLogEmin[particle] + k/fInvStep[particle]);
+    if (particle == CrossingRecord::kNeutron) {
+      sigma[k] = store->GetElasticCrossSectionPerVolume(neutron, energy, material)
+               + store->GetInelasticCrossSectionPerVolume(neutron, energy, material)
+               + store->GetCaptureCrossSectionPerVolume(neutron, energy, material)
+               + store->GetFissionCrossSectionPerVolume(neutron, energy, material);
+    } else {
+      G4double lambda = calculator.ComputeGammaAttenuationLength(energy, material);
+      sigma[k] = (lambda > 0. && lambda < DBL_MAX) ? 1./lambda : 0.;
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -34,19 +34,32 @@
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 #include "PrimaryGeneratorAction.hh"
+#include "PrimaryGeneratorMessenger.hh"
+#include "PhaseSpaceReader.hh"
 
 #include "G4Event.hh"
+#include "G4RunManager.hh"
 #include "G4ParticleTable.hh"
+#include "G4IonTable.hh"
 #include "G4ParticleDefinition.hh"
 #include "G4PhysicalConstants.hh"
 #include "G4SystemOfUnits.hh"
 #include "Randomize.hh"
 
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 PrimaryGeneratorAction::PrimaryGeneratorAction()
-: G4VUserPrimaryGeneratorAction(),fParticleGun(0)
+: G4VUserPrimaryGeneratorAction(),fParticleGun(0),fDetector(0),fGunMessenger(0),
+  fNbCos(36),fNbPhi(72),
+  fPhaseSpace(false),fReuse(1),fSmear(0.),fRecordWeight(1.),fUsesLeft(0)
 {
+  fDetector = static_cast<const DetectorConstruction*>
+                (G4RunManager::GetRunManager()->GetUserDetectorConstruction());
+
   G4int n_particle = 1;
   fParticleGun  = new G4ParticleGun(n_particle);
   
@@ -62,6 +75,7 @@ PrimaryGeneratorAction::PrimaryGeneratorAction()
   fParticleGun->SetParticleEnergy(2.5*MeV);
   fParticleGun->SetParticlePosition(sourcePos);
 
+  fGunMessenger = new PrimaryGeneratorMessenger(this);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -69,6 +83,7 @@ PrimaryGeneratorAction::PrimaryGeneratorAction()
 PrimaryGeneratorAction::~PrimaryGeneratorAction()
 {
   delete fParticleGun;
+  delete fGunMessenger;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -77,9 +92,26 @@ void PrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
 {
   //this function is called at the begining of event
   //
+  if (fPhaseSpace) {
+    GeneratePhaseSpacePrimary(anEvent);
+    return;
+  }
+
   //distribution uniform in solid angle
   //
   G4double cosTheta = 2*G4UniformRand() - 1., phi = twopi*G4UniformRand();
+  G4double weight = 1.;
+
+  //angular biasing: a bin from the alias table, uniform within the bin
+  //
+  if (!fBiasTable.IsEmpty()) {
+    G4int bin = fBiasTable.Sample(G4UniformRand(), G4UniformRand());
+    G4int ic = bin/fNbPhi, ip = bin%fNbPhi;
+    cosTheta = -1. + (ic + G4UniformRand())*2./fNbCos;
+    phi      = (ip + G4UniformRand())*twopi/fNbPhi;
+    weight   = fBiasWeight[bin];
+  }
+
   G4double sinTheta = std::sqrt(1. - cosTheta*cosTheta);
   G4double ux = sinTheta*std::cos(phi),
            uy = sinTheta*std::sin(phi),
@@ -88,7 +120,222 @@ void PrimaryGeneratorAction::GeneratePrimaries(G4Event* anEvent)
   fParticleGun->SetParticleMomentumDirection(G4ThreeVector(ux,uy,uz));
   
   fParticleGun->GeneratePrimaryVertex(anEvent);
+  if (weight != 1.) anEvent->GetPrimaryVertex(0)->SetWeight(weight);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PrimaryGeneratorAction::LoadAngularBias(const G4String& fileName)
+{
+  std::ifstream file(fileName);
+  if (!file) {
+    G4cout << "\n--> warning from PrimaryGeneratorAction::LoadAngularBias : "
+           << "cannot open " << fileName << G4endl;
+    return false;
+  }
+
+  G4int nbCos = 0, nbPhi = 0;
+  std::vector<G4double> probability;
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty()) continue;
+    if (line[0] == '#') {
+      size_t pos = line.find("bins:");
+      if (pos == std::string::npos) continue;
+      std::istringstream is(line.substr(pos+5));
+      is >> nbCos >> nbPhi;
+      if (nbCos > 0 && nbPhi > 0) probability.assign(nbCos*nbPhi, 0.);
+      continue;
+    }
+    // the weight column is recomputed from the probabilities
+    std::replace(line.begin(), line.end(), ',', ' ');
+    std::istringstream is(line);
+    G4int ic, ip;
+    G4double p;
+    if (!(is >> ic >> ip >> p)) continue;
+    if (ic < 0 || ic >= nbCos || ip < 0 || ip >= nbPhi) continue;
+    probability[ic*nbPhi + ip] = p;
+  }
+
+  if (probability.empty()) {
+    G4cout << "\n--> warning from PrimaryGeneratorAction::LoadAngularBias : "
+           << fileName << " has no bins; source left isotropic" << G4endl;
+    return false;
+  }
+  fNbCos = nbCos;
+  fNbPhi = nbPhi;
+  fBasePdf = probability;
+  UpdateAngularBias();
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::SetAngularBins(G4int nbCos, G4int nbPhi)
+{
+  // a new grid drops the pdf read from file
+  fNbCos = nbCos;
+  fNbPhi = nbPhi;
+  fBasePdf.clear();
+  UpdateAngularBias();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::AddBiasCone(const G4ThreeVector& axis,
+                                         G4double halfAngle, G4double factor)
+{
+  BiasCone cone;
+  cone.axis    = axis.unit();
+  cone.cosHalf = std::cos(halfAngle);
+  cone.factor  = factor;
+  fCones.push_back(cone);
+
+  // the pdf is constant over a bin: a cone must hold bin centres
+  if (twopi*(1. - cone.cosHalf) < 4*pi/(fNbCos*fNbPhi)) {
+    G4cout << "\n--> warning from PrimaryGeneratorAction::AddBiasCone : "
+           << "cone narrower than the angular bins, refine them with"
+           << " /testhadr/gun/angularBins" << G4endl;
+  }
+  UpdateAngularBias();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::ClearAngularBias()
+{
+  fBasePdf.clear();
+  fCones.clear();
+  UpdateAngularBias();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::UpdateAngularBias()
+{
+  fBiasTable.Clear();
+  fBiasWeight.clear();
+  if (fBasePdf.empty() && fCones.empty()) return;
+
+  // pdf of a bin: from file (or isotropic) times the largest factor of the
+  // cones holding the centre of the bin
+  G4int nbBins = fNbCos*fNbPhi;
+  std::vector<G4double> pdf(nbBins);
+  for (G4int ic=0; ic<fNbCos; ++ic) {
+    G4double cosTheta = -1. + (ic+0.5)*2./fNbCos;
+    G4double sinTheta = std::sqrt(1. - cosTheta*cosTheta);
+    for (G4int ip=0; ip<fNbPhi; ++ip) {
+      G4double phi = (ip+0.5)*twopi/fNbPhi;
+      G4ThreeVector u(sinTheta*std::cos(phi), sinTheta*std::sin(phi), cosTheta);
+      G4double factor = 0.;
+      for (size_t k=0; k<fCones.size(); ++k) {
+        if (u.dot(fCones[k].axis) >= fCones[k].cosHalf)
+          factor = std::max(factor, fCones[k].factor);
+      }
+      if (factor == 0.) factor = 1.;
+      G4int bin = ic*fNbPhi + ip;
+      pdf[bin] = (fBasePdf.empty() ? 1. : fBasePdf[bin])*factor;
+    }
+  }
+  if (!fBiasTable.Build(pdf)) return;
+
+  // bins of equal solid angle: isotropic probability 1/nbBins
+  fBiasWeight.resize(nbBins);
+  for (G4int b=0; b<nbBins; ++b) {
+    G4double p = fBiasTable.GetProbability(b);
+    fBiasWeight[b] = (p > 0.) ? (1./nbBins)/p : 0.;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorAction::GeneratePhaseSpacePrimary(G4Event* anEvent)
+{
+  // a new record once the current one has been used fReuse times
+  if (fUsesLeft == 0) {
+    if (!PhaseSpaceReader::Instance()->Next(fRecord)) return;  //empty event
+    fUsesLeft = fReuse;
+  }
+  --fUsesLeft;
+
+  G4ParticleDefinition* particle
+    = G4ParticleTable::GetParticleTable()->FindParticle(fRecord.pdg);
+  if (!particle && fRecord.pdg > 1000000000) {
+    particle = G4IonTable::GetIonTable()->GetIon(fRecord.pdg);
+  }
+  if (!particle) return;
+
+  G4ThreeVector position(fRecord.x*mm, fRecord.y*mm, fRecord.z*mm);
+  G4ThreeVector direction(fRecord.u, fRecord.v, fRecord.w);
+
+  // spread over the face crossed: the axis normal to it is kept
+  if (fSmear > 0.) {
+    G4ThreeVector center = fDetector->GetTankCenter();
+    G4ThreeVector half   = 0.5*fDetector->GetTankSize();
+    G4int normal = 0;
+    G4double dmax = 0.;
+    for (G4int i=0; i<3; ++i) {
+      G4double d = std::fabs(position[i] - center[i])/half[i];
+      if (d > dmax) { dmax = d; normal = i; }
+    }
+    for (G4int i=0; i<3; ++i) {
+      if (i == normal) continue;
+      G4double x = position[i] + G4RandGauss::shoot(0., fSmear);
+      position[i] = std::min(std::max(x, center[i] - half[i]), center[i] + half[i]);
+    }
+  }
+  // a record of the tank exits lies on its surface: start on the outer
+  // side (a micron is nothing to the gamma source of a two-phase run)
+  position += 1*um*direction;
+
+  fParticleGun->SetParticleDefinition(particle);
+  fParticleGun->SetParticlePosition(position);
+  fParticleGun->SetParticleMomentumDirection(direction.unit());
+  fParticleGun->SetParticleEnergy(fRecord.energy*MeV);
+  fParticleGun->SetParticleTime(fRecord.time*ns);
+  fParticleGun->GeneratePrimaryVertex(anEvent);
+  anEvent->GetPrimaryVertex(0)->SetWeight(fRecord.weight*fRecordWeight);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PrimaryGeneratorAction::LoadPhaseSpace(const G4String& fileName,
+                                              G4int reuse, G4double smear)
+{
+  PhaseSpaceReader* reader = PhaseSpaceReader::Instance();
+  if (!reader->Open(fileName)) return false;
+
+  // a record stands for nbPrimaries/nbRecords source neutrons, whatever
+  // the number of events it is used for
+  fPhaseSpace   = true;
+  fReuse        = std::max(reuse, 1);
+  fSmear        = smear;
+  fRecordWeight = G4double(reader->GetNbRecords())/reader->GetNbPrimaries();
+  fUsesLeft     = 0;
+  return true;
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+void PrimaryGeneratorAction::ClearPhaseSpace()
+{
+  // back to the point source
+  if (fPhaseSpace) PhaseSpaceReader::Instance()->Close();
+  fPhaseSpace = false;
+  fUsesLeft   = 0;
+  G4ParticleDefinition* particle
+           = G4ParticleTable::GetParticleTable()->FindParticle("neutron");
+  fParticleGun->SetParticleDefinition(particle);
+  fParticleGun->SetParticleEnergy(2.5*MeV);
+  fParticleGun->SetParticleTime(0.);
+  fParticleGun->SetParticlePosition(sourcePos);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool PrimaryGeneratorAction::ReplaysTankExits() const
+{
+  return fPhaseSpace && PhaseSpaceReader::Instance()->HoldsTankExits();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,199 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file PrimaryGeneratorMessenger.cc
+/// \brief Implementation of the PrimaryGeneratorMessenger class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "PrimaryGeneratorMessenger.hh"
+
+#include "PrimaryGeneratorAction.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithoutParameter.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PrimaryGeneratorMessenger::PrimaryGeneratorMessenger(PrimaryGeneratorAction* gun)
+:G4UImessenger(), fAction(gun),
+ fGunDir(0), fAngularBiasCmd(0), fBinsCmd(0), fConeCmd(0), fClearCmd(0),
+ fPhaseSpaceCmd(0)
+{
+  // one generator per worker: the commands are broadcast
+  fGunDir = new G4UIdirectory("/testhadr/gun/");
+  fGunDir->SetGuidance("primary generator");
+
+  fAngularBiasCmd = new G4UIcmdWithAString("/testhadr/gun/angularBias",this);
+  fAngularBiasCmd->SetGuidance("Read the angular biasing of the source from a");
+  fAngularBiasCmd->SetGuidance("file written by /testhadr/bias/cadis/run.");
+  fAngularBiasCmd->SetGuidance("none : same as /testhadr/gun/clearBias");
+  fAngularBiasCmd->SetParameterName("fileName",false);
+  fAngularBiasCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fBinsCmd = new G4UIcommand("/testhadr/gun/angularBins",this);
+  fBinsCmd->SetGuidance("Bins of the biased angular pdf of the cones:");
+  fBinsCmd->SetGuidance("nb of bins in cos(theta) and in phi (default 36 72)");
+  //
+  G4UIparameter* cosPrm = new G4UIparameter("nbCos",'i',false);
+  cosPrm->SetParameterRange("nbCos>0");
+  fBinsCmd->SetParameter(cosPrm);
+  //
+  G4UIparameter* phiPrm = new G4UIparameter("nbPhi",'i',false);
+  phiPrm->SetParameterRange("nbPhi>0");
+  fBinsCmd->SetParameter(phiPrm);
+  //
+  fBinsCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fConeCmd = new G4UIcommand("/testhadr/gun/biasCone",this);
+  fConeCmd->SetGuidance("Emit factor times more primaries per unit solid angle");
+  fConeCmd->SetGuidance("in a cone (e.g. toward a gap or the roof); the");
+  fConeCmd->SetGuidance("largest factor applies where cones overlap.");
+  //
+  const char* axis[] = { "ux", "uy", "uz" };
+  for (G4int i=0; i<3; ++i) {
+    G4UIparameter* uPrm = new G4UIparameter(axis[i],'d',false);
+    uPrm->SetGuidance("direction of the axis of the cone");
+    fConeCmd->SetParameter(uPrm);
+  }
+  //
+  G4UIparameter* anglePrm = new G4UIparameter("halfAngle",'d',false);
+  anglePrm->SetParameterRange("halfAngle>0.");
+  fConeCmd->SetParameter(anglePrm);
+  //
+  G4UIparameter* factorPrm = new G4UIparameter("factor",'d',false);
+  factorPrm->SetParameterRange("factor>0.");
+  fConeCmd->SetParameter(factorPrm);
+  //
+  G4UIparameter* unitPrm = new G4UIparameter("unit",'s',true);
+  unitPrm->SetDefaultValue("deg");
+  unitPrm->SetParameterCandidates("deg rad mrad");
+  fConeCmd->SetParameter(unitPrm);
+  //
+  fConeCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fClearCmd = new G4UIcmdWithoutParameter("/testhadr/gun/clearBias",this);
+  fClearCmd->SetGuidance("Remove the cones and the pdf read from file:");
+  fClearCmd->SetGuidance("isotropic source");
+  fClearCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fPhaseSpaceCmd = new G4UIcommand("/testhadr/gun/phaseSpace",this);
+  fPhaseSpaceCmd->SetGuidance("Replay the particles leaving the tank, written by");
+  fPhaseSpaceCmd->SetGuidance("/testhadr/output/phaseSpace, as the primaries:");
+  fPhaseSpaceCmd->SetGuidance("each record makes 'reuse' consecutive events, its");
+  fPhaseSpaceCmd->SetGuidance("position spread over the face of the tank by a");
+  fPhaseSpaceCmd->SetGuidance("gaussian of width 'smear' (0: as recorded).");
+  fPhaseSpaceCmd->SetGuidance("Run nbRecords*reuse events to use each record");
+  fPhaseSpaceCmd->SetGuidance("'reuse' times. none : back to the point source");
+  //
+  G4UIparameter* filePrm = new G4UIparameter("fileName",'s',false);
+  fPhaseSpaceCmd->SetParameter(filePrm);
+  //
+  G4UIparameter* reusePrm = new G4UIparameter("reuse",'i',true);
+  reusePrm->SetDefaultValue(1);
+  reusePrm->SetParameterRange("reuse>0");
+  fPhaseSpaceCmd->SetParameter(reusePrm);
+  //
+  G4UIparameter* smearPrm = new G4UIparameter("smear",'d',true);
+  smearPrm->SetDefaultValue(0.);
+  smearPrm->SetParameterRange("smear>=0.");
+  fPhaseSpaceCmd->SetParameter(smearPrm);
+  //
+  G4UIparameter* lengthPrm = new G4UIparameter("unit",'s',true);
+  lengthPrm->SetDefaultValue("cm");
+  lengthPrm->SetParameterCandidates("mm cm m");
+  fPhaseSpaceCmd->SetParameter(lengthPrm);
+  //
+  fPhaseSpaceCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+PrimaryGeneratorMessenger::~PrimaryGeneratorMessenger()
+{
+  delete fAngularBiasCmd;
+  delete fBinsCmd;
+  delete fConeCmd;
+  delete fClearCmd;
+  delete fPhaseSpaceCmd;
+  delete fGunDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void PrimaryGeneratorMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fAngularBiasCmd)
+   {
+     if (newValue == "none") fAction->ClearAngularBias();
+     else                    fAction->LoadAngularBias(newValue);
+   }
+
+  if (command == fBinsCmd)
+   {
+     G4int nbCos, nbPhi;
+     std::istringstream is(newValue);
+     is >> nbCos >> nbPhi;
+     fAction->SetAngularBins(nbCos, nbPhi);
+   }
+
+  if (command == fConeCmd)
+   {
+     G4double ux, uy, uz, halfAngle, factor;
+     G4String unit;
+     std::istringstream is(newValue);
+     is >> ux >> uy >> uz >> halfAngle >> factor >> unit;
+     G4ThreeVector axis(ux, uy, uz);
+     if (axis.mag2() == 0.) {
+       G4cout << "\n--> warning from PrimaryGeneratorMessenger : "
+              << "null axis of the cone, ignored" << G4endl;
+       return;
+     }
+     fAction->AddBiasCone(axis, halfAngle*G4UIcommand::ValueOf(unit), factor);
+   }
+
+  if (command == fClearCmd)
+   { fAction->ClearAngularBias(); }
+
+  if (command == fPhaseSpaceCmd)
+   {
+     G4String fileName, unit;
+     G4int reuse;
+     G4double smear;
+     std::istringstream is(newValue);
+     is >> fileName >> reuse >> smear >> unit;
+     if (fileName == "none") fAction->ClearPhaseSpace();
+     else fAction->LoadPhaseSpace(fileName, reuse,
+                                  smear*G4UIcommand::ValueOf(unit));
+   }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -35,9 +35,18 @@
 #include "PrimaryGeneratorAction.hh"
 #include "HistoManager.hh"
 
+#include "G4ParticleDefinition.hh"
 #include "G4UnitsTable.hh"
 #include "G4SystemOfUnits.hh"
 
+#include <algorithm>
+#include <map>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+NameRegistry Run::fgProcessNames;
+NameRegistry Run::fgParticleNames;
+
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 Run::Run(DetectorConstruction* det)
@@ -45,7 +54,8 @@ Run::Run(DetectorConstruction* det)
   fDetector(det), fParticle(0), fEkin(0.),
   fNbStep1(0), fNbStep2(0),
   fTrackLen1(0.), fTrackLen2(0.),
-  fTime1(0.),fTime2(0.)
+  fTime1(0.),fTime2(0.),
+  fNbSteps(0.), fNbStepAllocs(0.), fNbStepsWithAllocs(0.)
 { }
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
@@ -62,36 +72,32 @@ void Run::SetPrimary(G4ParticleDefinition* particle, G4double energy)
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void Run::CountProcesses(const G4VProcess* process) 
+G4int Run::RegisterProcess(const G4VProcess* process) 
 {
-  G4String procName = process->GetProcessName();
-  std::map<G4String,G4int>::iterator it = fProcCounter.find(procName);
-  if ( it == fProcCounter.end()) {
-    fProcCounter[procName] = 1;
-  }
-  else {
-    fProcCounter[procName]++; 
-  }
+  G4int id = fgProcessNames.Register(process->GetProcessName());
+  fProcIndex.Insert(process, id);
+  if (id >= G4int(fProcCounter.size())) fProcCounter.resize(id+1, 0);
+  return id;
 }                 
                   
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-void Run::ParticleCount(G4String name, G4double Ekin)
+G4int Run::RegisterParticle(const G4ParticleDefinition* particle)
 {
-  std::map<G4String, ParticleData>::iterator it = fParticleDataMap.find(name);
-  if ( it == fParticleDataMap.end()) {
-    fParticleDataMap[name] = ParticleData(1, Ekin, Ekin, Ekin);
-  }
-  else {
-    ParticleData& data = it->second;
-    data.fCount++;
-    data.fEmean += Ekin;
-    //update min max
-    G4double emin = data.fEmin;
-    if (Ekin < emin) data.fEmin = Ekin;
-    G4double emax = data.fEmax;
-    if (Ekin > emax) data.fEmax = Ekin; 
-  }   
+  G4int id = fgParticleNames.Register(particle->GetParticleName());
+  fParticleIndex.Insert(particle, id);
+  if (id >= G4int(fPartCount.size())) ResizeParticleData(id+1);
+  return id;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void Run::ResizeParticleData(size_t n)
+{
+  fPartCount.resize(n, 0);
+  fPartEsum.resize(n, 0.);
+  fPartEmin.resize(n, DBL_MAX);
+  fPartEmax.resize(n, 0.);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -107,6 +113,17 @@ void Run::SumTrackLength(G4int nstep1, G4int nstep2,
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+void Run::CountStepAllocations(size_t nbAlloc)
+{
+  fNbSteps += 1.;
+  if (nbAlloc > 0) {
+    fNbStepAllocs += nbAlloc;
+    fNbStepsWithAllocs += 1.;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 void Run::Merge(const G4Run* run)
 {
   const Run* localRun = static_cast<const Run*>(run);
@@ -124,45 +141,35 @@ void Run::Merge(const G4Run* run)
   fTrackLen2 += localRun->fTrackLen2;
   fTime1     += localRun->fTime1;  
   fTime2     += localRun->fTime2;
+  fNbSteps          += localRun->fNbSteps;
+  fNbStepAllocs     += localRun->fNbStepAllocs;
+  fNbStepsWithAllocs += localRun->fNbStepsWithAllocs;
+
+  //dose-rate maps of the lab walls
+  if (fSurfaceTally.IsBooked()) fSurfaceTally.Merge(localRun->fSurfaceTally);
+  if (fMeshTally.IsBooked())    fMeshTally.Merge(localRun->fMeshTally);
+  if (fSparseMesh.IsBooked())   fSparseMesh.Merge(localRun->fSparseMesh);
+  if (fWindowFlux.IsBooked())   fWindowFlux.Merge(localRun->fWindowFlux);
+  if (fPointTally.IsBooked())   fPointTally.Merge(localRun->fPointTally);
   
-  //map: processes count
-  std::map<G4String,G4int>::const_iterator itp;
-  for ( itp = localRun->fProcCounter.begin();
-        itp != localRun->fProcCounter.end(); ++itp ) {
-
-    G4String procName = itp->first;
-    G4int localCount = itp->second;
-    if ( fProcCounter.find(procName) == fProcCounter.end()) {
-      fProcCounter[procName] = localCount;
-    }
-    else {
-      fProcCounter[procName] += localCount;
-    }  
-  }
+  //processes count: dense arrays indexed by the shared process IDs
+  size_t nproc = localRun->fProcCounter.size();
+  if (fProcCounter.size() < nproc) fProcCounter.resize(nproc, 0);
+  const G4int* procCount = localRun->fProcCounter.data();
+  for (size_t i=0; i<nproc; ++i) fProcCounter[i] += procCount[i];
    
-  //map: created particles count         
-  std::map<G4String,ParticleData>::const_iterator itn;
-  for (itn = localRun->fParticleDataMap.begin(); 
-       itn != localRun->fParticleDataMap.end(); ++itn) {
-    
-    G4String name = itn->first;
-    const ParticleData& localData = itn->second;   
-    if ( fParticleDataMap.find(name) == fParticleDataMap.end()) {
-      fParticleDataMap[name]
-       = ParticleData(localData.fCount, 
-                      localData.fEmean, 
-                      localData.fEmin, 
-                      localData.fEmax);
-    }
-    else {
-      ParticleData& data = fParticleDataMap[name];   
-      data.fCount += localData.fCount;
-      data.fEmean += localData.fEmean;
-      G4double emin = localData.fEmin;
-      if (emin < data.fEmin) data.fEmin = emin;
-      G4double emax = localData.fEmax;
-      if (emax > data.fEmax) data.fEmax = emax; 
-    }   
+  //created particles count: dense arrays indexed by the shared particle IDs
+  size_t npart = localRun->fPartCount.size();
+  if (fPartCount.size() < npart) ResizeParticleData(npart);
+  const G4int*    count = localRun->fPartCount.data();
+  const G4double* esum  = localRun->fPartEsum.data();
+  const G4double* emin  = localRun->fPartEmin.data();
+  const G4double* emax  = localRun->fPartEmax.data();
+  for (size_t i=0; i<npart; ++i) {
+    fPartCount[i] += count[i];
+    fPartEsum[i]  += esum[i];
+    fPartEmin[i]   = std::min(fPartEmin[i], emin[i]);
+    fPartEmax[i]   = std::max(fPartEmax[i], emax[i]);
   }
 
   G4Run::Merge(run); 
@@ -193,8 +200,13 @@ void Run::EndOfRun()
   //
   G4cout << "\n Process calls frequency :" << G4endl;  
   G4int survive = 0;
+  std::map<G4String,G4int> procCounter;
+  for (size_t i=0; i<fProcCounter.size(); ++i) {
+     if (fProcCounter[i] > 0) 
+       procCounter[fgProcessNames.GetName(i)] = fProcCounter[i];
+  }
   std::map<G4String,G4int>::iterator it;    
-  for (it = fProcCounter.begin(); it != fProcCounter.end(); it++) {
+  for (it = procCounter.begin(); it != procCounter.end(); it++) {
      G4String procName = it->first;
      G4int    count    = it->second;
      G4cout << "\t" << procName << "= " << count;
@@ -242,14 +254,18 @@ void Run::EndOfRun()
  //
  G4cout << "\n List of generated particles:" << G4endl;
      
- std::map<G4String,ParticleData>::iterator itn;               
- for (itn = fParticleDataMap.begin(); itn != fParticleDataMap.end(); itn++) { 
+ std::map<G4String,G4int> particleIds;
+ for (size_t i=0; i<fPartCount.size(); ++i) {
+    if (fPartCount[i] > 0) particleIds[fgParticleNames.GetName(i)] = i;
+ }
+ std::map<G4String,G4int>::iterator itn;               
+ for (itn = particleIds.begin(); itn != particleIds.end(); itn++) { 
     G4String name = itn->first;
-    ParticleData data = itn->second;
-    G4int count = data.fCount;
-    G4double eMean = data.fEmean/count;
-    G4double eMin = data.fEmin;
-    G4double eMax = data.fEmax;    
+    G4int id = itn->second;
+    G4int count = fPartCount[id];
+    G4double eMean = fPartEsum[id]/count;
+    G4double eMin = fPartEmin[id];
+    G4double eMax = fPartEmax[id];    
          
     G4cout << "  " << std::setw(13) << name << ": " << std::setw(7) << count
            << "  Emean = " << std::setw(wid) << G4BestUnit(eMean, "Energy")
@@ -257,6 +273,22 @@ void Run::EndOfRun()
            << " --> " << G4BestUnit(eMax, "Energy") 
            << ")" << G4endl;           
  }
+
+#ifdef MONITOR_COUNT_ALLOCATIONS
+ //heap allocations in the stepping action
+ //
+ if (fNbSteps > 0.) {
+   G4cout << "\n Heap allocations in SteppingAction: " << fNbStepAllocs
+          << " in " << fNbStepsWithAllocs << " of " << fNbSteps << " steps"
+          << " (" << fNbStepAllocs/fNbSteps << " per step)" << G4endl;
+ }
+#endif
+
+ //dose rate on the lab walls
+ //
+ fSurfaceTally.Print(numberOfEvent);
+ fMeshTally.Print(numberOfEvent);
+ fSparseMesh.Print(numberOfEvent);
  
   //normalize histograms      
   ////G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
@@ -264,8 +296,11 @@ void Run::EndOfRun()
   ////analysisManager->ScaleH1(3,factor);
            
   //remove all contents in fProcCounter, fCount 
-  fProcCounter.clear();
-  fParticleDataMap.clear();
+  std::fill(fProcCounter.begin(), fProcCounter.end(), 0);
+  std::fill(fPartCount.begin(), fPartCount.end(), 0);
+  std::fill(fPartEsum.begin(), fPartEsum.end(), 0.);
+  std::fill(fPartEmin.begin(), fPartEmin.end(), DBL_MAX);
+  std::fill(fPartEmax.begin(), fPartEmax.end(), 0.);
                           
   //restore default format         
   G4cout.precision(dfprec);   
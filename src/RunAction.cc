@@ -35,8 +35,22 @@
 #include "DetectorConstruction.hh"
 #include "PrimaryGeneratorAction.hh"
 #include "HistoManager.hh"
+#include "SteppingAction.hh"
+#include "StackingAction.hh"
+#include "CrossingBuffer.hh"
+#include "CrossingWriter.hh"
+#include "PointEstimator.hh"
+#include "PhaseSpaceWriter.hh"
+#include "ScoringWorld.hh"
+#include "MeshSD.hh"
+#include "ImportanceWorld.hh"
+#include "WeightWindowWorld.hh"
+#include "WeightWindowSD.hh"
 
 #include "G4Run.hh"
+#include "G4SDManager.hh"
+#include "G4Timer.hh"
+#include "G4Threading.hh"
 #include "G4UnitsTable.hh"
 #include "G4SystemOfUnits.hh"
 
@@ -47,16 +61,34 @@
 
 RunAction::RunAction(DetectorConstruction* det, PrimaryGeneratorAction* prim)
   : G4UserRunAction(),
-    fDetector(det), fPrimary(prim), fRun(0), fHistoManager(0)
+    fDetector(det), fPrimary(prim), fRun(0), fHistoManager(0),
+    fSteppingAction(0), fStackingAction(0), fCrossingBuffer(0),
+    fPointEstimator(0), fPhaseSpaceBuffer(0), fGammaSourceBuffer(0)
 {
  // Book predefined histograms
  fHistoManager = new HistoManager(); 
+
+ // boundary crossings are written to the ntuples block by block
+ fCrossingBuffer = new CrossingBuffer(fHistoManager);
+
+ // next-event estimator of the point detectors, with its own navigator
+ fPointEstimator = new PointEstimator();
+
+ // particles leaving the tank, handed to the phase-space file by blocks
+ fPhaseSpaceBuffer = new PhaseSpaceBuffer();
+
+ // gammas of the neutron phase of a two-phase run, idem
+ fGammaSourceBuffer = new PhaseSpaceBuffer(PhaseSpaceWriter::kGammaSource);
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 RunAction::~RunAction()
 {
+ delete fGammaSourceBuffer;
+ delete fPhaseSpaceBuffer;
+ delete fPointEstimator;
+ delete fCrossingBuffer;
  delete fHistoManager;
 }
 
@@ -74,6 +106,20 @@ void RunAction::BeginOfRunAction(const G4Run*)
 {    
   // show Rndm status
   if (isMaster) G4Random::showEngineStatus();
+
+  // the figure of merit of the biased tallies needs the run duration
+  if (isMaster) fRunTimer.Start();
+
+  // importances of the biasing cells, in the store of this thread
+  fDetector->GetImportanceWorld()->UpdateImportanceStore();
+
+  // weight windows of the mesh cells, or fluence of a pilot run
+  WeightWindowWorld* windows = fDetector->GetWeightWindowWorld();
+  windows->UpdateWindowStore();
+  if (windows->IsGenerating()) fRun->GetWindowFlux()->Book(windows->GetNbCells());
+  WeightWindowSD* windowSD = static_cast<WeightWindowSD*>(
+    G4SDManager::GetSDMpointer()->FindSensitiveDetector("WeightWindowSD", false));
+  if (windowSD) windowSD->BeginOfRun(fRun->GetWindowFlux());
   
   // keep run condition
   if (fPrimary) { 
@@ -82,27 +128,153 @@ void RunAction::BeginOfRunAction(const G4Run*)
     G4double energy = fPrimary->GetParticleGun()->GetParticleEnergy();
     fRun->SetPrimary(particle, energy);
   }
+
+  // dose-rate maps of the lab walls, laid out on the room
+  SurfaceTally* tally = fRun->GetSurfaceTally();
+  if (fHistoManager->HasSurfaceTally()) {
+    fHistoManager->ConfigureSurfaceTally(tally);
+    tally->Book(fDetector->GetRoomCenter(), fDetector->GetRoomSize());
+  }
+
+  // dose-rate mesh, on the voxels of the scoring world
+  const ScoringWorld* scoring = fDetector->GetScoringWorld();
+  if (scoring->HasMesh()) {
+    MeshTally* mesh = fRun->GetMeshTally();
+    fHistoManager->ConfigureMeshTally(mesh);
+    mesh->Book(scoring->GetMeshOrigin(), scoring->GetVoxelSize(),
+               scoring->GetNbVoxels(0), scoring->GetNbVoxels(1),
+               scoring->GetNbVoxels(2));
+    MeshSD* meshSD = static_cast<MeshSD*>(G4SDManager::GetSDMpointer()
+                       ->FindSensitiveDetector("MeshSD", false));
+    if (meshSD) meshSD->BeginOfRun(mesh);
+  }
+
+  // sparse mesh of the room, filled by the stepping action
+  if (fHistoManager->HasSparseMesh()) {
+    SparseMeshTally* sparse = fRun->GetSparseMesh();
+    fHistoManager->ConfigureSparseMesh(sparse);
+    sparse->Book(fDetector->GetRoomCenter() - 0.5*fDetector->GetRoomSize(),
+                 fDetector->GetRoomSize(), fHistoManager->GetSparseVoxelSize());
+  }
+
+  // point detectors, scored by the next-event estimator of this thread
+  PointDetectorTally* points = fRun->GetPointTally();
+  if (fHistoManager->HasPointDetectors()) {
+    fHistoManager->ConfigurePointTally(points);
+    points->Book(fHistoManager->GetPointDetectors());
+    fPointEstimator->BeginOfRun(fDetector->worldP, points,
+                                fHistoManager->GetPointMinDistance(),
+                                fHistoManager->GetPointCacheCell());
+  }
+
+  // a phase-space source is not an isotropic emission of unit weight:
+  // the point detectors stay booked, to be merged, but are not scored
+  G4bool replay = fPrimary && fPrimary->HasPhaseSpace();
+  if (replay && points->IsBooked() && G4Threading::G4GetThreadId() <= 0) {
+    G4cout << "\n--> warning from RunAction::BeginOfRunAction : "
+           << "point detectors are not scored with a phase-space source"
+           << G4endl;
+  }
+
+  // per-thread lookup tables of the stepping action
+  if (fSteppingAction) {
+    fSteppingAction->BeginOfRun(fRun,
+      fHistoManager->WritesCrossings() ? fCrossingBuffer : 0,
+      (points->IsBooked() && !replay) ? fPointEstimator : 0,
+      fHistoManager->WritesPhaseSpace() ? fPhaseSpaceBuffer : 0,
+      fPrimary && fPrimary->ReplaysTankExits());
+  }
+  if (fStackingAction) {
+    fStackingAction->BeginOfRun(
+      fHistoManager->WritesGammaSource() ? fGammaSourceBuffer : 0);
+  }
              
   //histograms
   //
   G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
+  fHistoManager->BookNtuples();
+  if (tally->IsBooked()) fHistoManager->BookSurfaceMaps(*tally);
   if ( analysisManager->IsActive() ) {
     analysisManager->OpenFile();
   }  
+
+  // start the writer thread of the binary crossing records
+  if (isMaster && fHistoManager->WritesBinaryCrossings()) {
+    CrossingWriter::Instance()->Open(analysisManager->GetFileName()
+                                     + "_crossings.bin");
+  }
+
+  // surface source of the tank, filled by all threads
+  if (isMaster && fHistoManager->WritesPhaseSpace()) {
+    PhaseSpaceWriter::Instance()->Open(fHistoManager->GetPhaseSpaceFile());
+  }
+  if (isMaster && fHistoManager->WritesGammaSource()) {
+    PhaseSpaceWriter::Instance(PhaseSpaceWriter::kGammaSource)
+      ->Open(fHistoManager->GetGammaSourceFile());
+  }
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 void RunAction::EndOfRunAction(const G4Run*)
 {
-  if (isMaster) fRun->EndOfRun();    
+  if (isMaster) {
+    fRunTimer.Stop();
+    fRun->EndOfRun();
+    fRun->GetSurfaceTally()->PrintFigureOfMerit(fRun->GetNumberOfEvent(),
+                                                fRunTimer.GetRealElapsed());
+    fRun->GetPointTally()->Print(fRun->GetNumberOfEvent(),
+                                 fRunTimer.GetRealElapsed());
+    fHistoManager->FillSurfaceMaps(*fRun->GetSurfaceTally(),
+                                   fRun->GetNumberOfEvent());
+    G4String fileName = G4AnalysisManager::Instance()->GetFileName();
+    fRun->GetMeshTally()->Write(fileName + "_mesh.csv",
+                                fRun->GetNumberOfEvent());
+    fRun->GetSparseMesh()->Write(fileName + "_sparse.csv",
+                                 fRun->GetNumberOfEvent());
+    if (fRun->GetWindowFlux()->IsBooked()) {
+      fDetector->GetWeightWindowWorld()->GenerateWindows(*fRun->GetWindowFlux());
+    }
+  }
   
-  //save histograms      
+  // rays of the point detectors traced by this thread
+  G4double traced = fPointEstimator->GetNbTraced(),
+           cached = fPointEstimator->GetNbCached();
+  if (traced + cached > 0.) {
+    G4cout << "\n Point detectors: " << traced << " rays traced, "
+           << 100.*cached/(traced + cached) << " % taken from the cache"
+           << "\n                  "
+           << 100.*fPointEstimator->GetNbIsotropic()/fPointEstimator->GetNbScored()
+           << " % of the emissions and collisions scored isotropic in place"
+           << " of their law (thermal or unmodelled scattering, bremsstrahlung)"
+           << G4endl;
+  }
+
+  //write the pending crossings and phase space, then save histograms      
+  G4Timer timer;
+  timer.Start();
+  fCrossingBuffer->Flush();
+  if (isMaster) CrossingWriter::Instance()->Close();
+  fPhaseSpaceBuffer->Flush();
+  fGammaSourceBuffer->Flush();
+  if (isMaster) {
+    PhaseSpaceWriter::Instance()->Close(fRun->GetNumberOfEvent());
+    PhaseSpaceWriter::Instance(PhaseSpaceWriter::kGammaSource)
+      ->Close(fRun->GetNumberOfEvent());
+  }
   G4AnalysisManager* analysisManager = G4AnalysisManager::Instance();
   if ( analysisManager->IsActive() ) {
     analysisManager->Write();
     analysisManager->CloseFile();
   }
+  timer.Stop();
+  if (isMaster)
+    G4cout << "\n End-of-run output written in " << timer.GetRealElapsed()
+           << " s" << G4endl;
+  else
+    G4cout << "\n Thread " << G4Threading::G4GetThreadId()
+           << " : end-of-run output written in " << timer.GetRealElapsed()
+           << " s" << G4endl;
       
   // show Rndm status
   if (isMaster) G4Random::showEngineStatus();
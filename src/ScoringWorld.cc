@@ -0,0 +1,112 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file ScoringWorld.cc
+/// \brief Implementation of the ScoringWorld class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "ScoringWorld.hh"
+#include "DetectorConstruction.hh"
+#include "MeshSD.hh"
+
+#include "G4Box.hh"
+#include "G4LogicalVolume.hh"
+#include "G4PVPlacement.hh"
+#include "G4PVReplica.hh"
+#include "G4SDManager.hh"
+#include "G4SystemOfUnits.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ScoringWorld::ScoringWorld(const G4String& worldName,
+                           DetectorConstruction* det)
+  : G4VUserParallelWorld(worldName), fDetector(det), fVoxelL(0)
+{
+  fNbVoxels[0] = fNbVoxels[1] = fNbVoxels[2] = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ScoringWorld::~ScoringWorld()
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ScoringWorld::SetNbVoxels(G4int nx, G4int ny, G4int nz)
+{
+  fNbVoxels[0] = nx;
+  fNbVoxels[1] = ny;
+  fNbVoxels[2] = nz;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ScoringWorld::Construct()
+{
+  if (!HasMesh()) return;
+
+  G4LogicalVolume* worldL = GetWorld()->GetLogicalVolume();
+
+  // the mesh covers the room of the mass geometry
+  G4ThreeVector center = fDetector->GetRoomCenter();
+  G4ThreeVector size   = fDetector->GetRoomSize();
+  G4int nx = fNbVoxels[0], ny = fNbVoxels[1], nz = fNbVoxels[2];
+  fVoxelSize = G4ThreeVector(size.x()/nx, size.y()/ny, size.z()/nz);
+  fOrigin    = center - 0.5*size;
+
+  G4Box* meshS = new G4Box("Mesh", size.x()/2, size.y()/2, size.z()/2);
+  G4LogicalVolume* meshL = new G4LogicalVolume(meshS, 0, "Mesh");
+  new G4PVPlacement(0, center, meshL, "Mesh", worldL, false, 0);
+
+  // slices along x, rows along y, voxels along z
+  G4Box* sliceS = new G4Box("MeshX", fVoxelSize.x()/2, size.y()/2, size.z()/2);
+  G4LogicalVolume* sliceL = new G4LogicalVolume(sliceS, 0, "MeshX");
+  new G4PVReplica("MeshX", sliceL, meshL, kXAxis, nx, fVoxelSize.x());
+
+  G4Box* rowS = new G4Box("MeshY", fVoxelSize.x()/2, fVoxelSize.y()/2, size.z()/2);
+  G4LogicalVolume* rowL = new G4LogicalVolume(rowS, 0, "MeshY");
+  new G4PVReplica("MeshY", rowL, sliceL, kYAxis, ny, fVoxelSize.y());
+
+  G4Box* voxelS = new G4Box("MeshZ", fVoxelSize.x()/2, fVoxelSize.y()/2,
+                            fVoxelSize.z()/2);
+  fVoxelL = new G4LogicalVolume(voxelS, 0, "MeshZ");
+  new G4PVReplica("MeshZ", fVoxelL, rowL, kZAxis, nz, fVoxelSize.z());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ScoringWorld::ConstructSD()
+{
+  if (!fVoxelL) return;
+
+  MeshSD* meshSD = new MeshSD("MeshSD");
+  G4SDManager::GetSDMpointer()->AddNewDetector(meshSD);
+  SetSensitiveDetector(fVoxelL, meshSD);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,276 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file SparseMeshTally.cc
+/// \brief Implementation of the SparseMeshTally class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "SparseMeshTally.hh"
+
+#include "G4SystemOfUnits.hh"
+#include "G4UnitsTable.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+SparseMeshTally::SparseMeshTally()
+  : fSourceRate(1.e8), fDose(0), fVoxelSize(0.), fMask(0), fSize(0)
+{
+  fNbVoxels[0] = fNbVoxels[1] = fNbVoxels[2] = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+SparseMeshTally::~SparseMeshTally()
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SparseMeshTally::Book(const G4ThreeVector& origin,
+                           const G4ThreeVector& size, G4double voxelSize)
+{
+  fOrigin    = origin;
+  fVoxelSize = voxelSize;
+  for (G4int i=0; i<3; ++i) {
+    fNbVoxels[i] = std::max(1, G4int(std::ceil(size[i]/voxelSize)));
+  }
+
+  Voxel empty;
+  empty.key = kEmpty;
+  for (G4int p=0; p<kNbParticles; ++p) empty.length[p] = empty.dose[p] = 0.;
+  fVoxels.assign(kInitialSize, empty);
+  fMask = kInitialSize - 1;
+  fSize = 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SparseMeshTally::Grow()
+{
+  std::vector<Voxel> voxels;
+  voxels.swap(fVoxels);
+
+  Voxel empty = voxels[0];
+  empty.key = kEmpty;
+  for (G4int p=0; p<kNbParticles; ++p) empty.length[p] = empty.dose[p] = 0.;
+  fVoxels.assign(2*voxels.size(), empty);
+  fMask = fVoxels.size() - 1;
+  fSize = 0;
+
+  for (size_t i=0; i<voxels.size(); ++i) {
+    if (voxels[i].key == kEmpty) continue;
+    Get(voxels[i].key) = voxels[i];
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SparseMeshTally::ScoreSegment(G4int particle, const G4ThreeVector& start,
+                                   const G4ThreeVector& end, G4double energy,
+                                   G4double weight)
+{
+  // the segment in voxel units, a + t*(b-a) with t in [0,1]
+  G4double a[3], delta[3];
+  for (G4int i=0; i<3; ++i) {
+    a[i]     = (start[i] - fOrigin[i])/fVoxelSize;
+    delta[i] = (end[i] - start[i])/fVoxelSize;
+  }
+  G4double length = (end - start).mag();
+  if (length <= 0.) return;
+
+  // clip to the mesh
+  G4double t0 = 0., t1 = 1.;
+  for (G4int i=0; i<3; ++i) {
+    if (delta[i] == 0.) {
+      if (a[i] < 0. || a[i] >= fNbVoxels[i]) return;
+      continue;
+    }
+    G4double ta = -a[i]/delta[i];
+    G4double tb = (fNbVoxels[i] - a[i])/delta[i];
+    if (ta > tb) std::swap(ta, tb);
+    t0 = std::max(t0, ta);
+    t1 = std::min(t1, tb);
+  }
+  if (t0 >= t1) return;
+
+  // DDA: walk the voxels in order, t advancing to the next voxel face
+  G4int    index[3], step[3];
+  G4double tMax[3], tDelta[3];
+  G4double tMid = 0.5*(t0 + t1);
+  for (G4int i=0; i<3; ++i) {
+    // entry voxel, taken at the midpoint side of t0 against round-off
+    G4double u = a[i] + std::min(t0 + 1.e-9, tMid)*delta[i];
+    index[i] = std::min(std::max(G4int(std::floor(u)), 0), fNbVoxels[i]-1);
+    if (delta[i] > 0.) {
+      step[i]   = 1;
+      tMax[i]   = (index[i] + 1 - a[i])/delta[i];
+      tDelta[i] = 1./delta[i];
+    } else if (delta[i] < 0.) {
+      step[i]   = -1;
+      tMax[i]   = (index[i] - a[i])/delta[i];
+      tDelta[i] = -1./delta[i];
+    } else {
+      step[i]   = 0;
+      tMax[i]   = DBL_MAX;
+      tDelta[i] = DBL_MAX;
+    }
+  }
+
+  G4double wLength = weight*length;
+  G4double h = fDose->GetCoefficient(particle, energy);
+  G4double t = t0;
+  while (t < t1) {
+    G4int axis = (tMax[0] < tMax[1]) ? ((tMax[0] < tMax[2]) ? 0 : 2)
+                                     : ((tMax[1] < tMax[2]) ? 1 : 2);
+    G4double tNext = std::min(tMax[axis], t1);
+    Voxel& voxel = Get(Key(index[0], index[1], index[2]));
+    voxel.length[particle] += wLength*(tNext - t);
+    voxel.dose[particle]   += wLength*(tNext - t)*h;
+    t = tNext;
+
+    index[axis] += step[axis];
+    if (index[axis] < 0 || index[axis] >= fNbVoxels[axis]) break;
+    tMax[axis] += tDelta[axis];
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SparseMeshTally::Merge(const SparseMeshTally& other)
+{
+  if (other.fVoxelSize != fVoxelSize) {
+    G4cout << "\n--> warning from SparseMeshTally::Merge : "
+           << "mesh differs between threads, tally not merged" << G4endl;
+    return;
+  }
+  for (size_t i=0; i<other.fVoxels.size(); ++i) {
+    const Voxel& from = other.fVoxels[i];
+    if (from.key == kEmpty) continue;
+    Voxel& to = Get(from.key);
+    for (G4int p=0; p<kNbParticles; ++p) {
+      to.length[p] += from.length[p];
+      to.dose[p]   += from.dose[p];
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SparseMeshTally::Print(G4int nbEvents) const
+{
+  if (!IsBooked() || nbEvents == 0) return;
+
+  const char* particleName[kNbParticles] = { "neutron", "gamma" };
+
+  // pSv per primary in a voxel -> microSv/h at the source rate
+  G4double volume = std::pow(fVoxelSize/cm, 3);
+  G4double norm = fSourceRate/nbEvents * 3600. * 1.e-6/(volume*cm);
+
+  G4double dense = G4double(fNbVoxels[0])*fNbVoxels[1]*fNbVoxels[2];
+  G4int dfprec = G4cout.precision(4);
+  G4cout << "\n Sparse dose-rate mesh of the room: "
+         << G4BestUnit(fVoxelSize,"Length") << "voxels, " << fSize
+         << " scored of " << dense << " ("
+         << fVoxels.size()*sizeof(Voxel)/1048576. << " MB instead of "
+         << dense*2*kNbParticles*sizeof(G4double)/1048576. << " MB dense)"
+         << G4endl;
+
+  for (G4int p=0; p<kNbParticles; ++p) {
+    G4double peak = 0.;
+    uint64_t keyPeak = 0;
+    for (size_t i=0; i<fVoxels.size(); ++i) {
+      if (fVoxels[i].key == kEmpty) continue;
+      if (fVoxels[i].dose[p] > peak) {
+        peak = fVoxels[i].dose[p];
+        keyPeak = fVoxels[i].key;
+      }
+    }
+    G4int mask = (1 << 21) - 1;
+    G4cout << "  " << std::setw(8) << particleName[p]
+           << ": peak = " << peak*norm << " microSv/h in voxel ("
+           << G4int(keyPeak >> 42) << "," << (G4int(keyPeak >> 21) & mask)
+           << "," << (G4int(keyPeak) & mask) << ")" << G4endl;
+  }
+  G4cout.precision(dfprec);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool SparseMeshTally::Write(const G4String& fileName, G4int nbEvents) const
+{
+  if (!IsBooked()) return false;
+
+  std::ofstream file(fileName);
+  if (!file) {
+    G4cout << "\n--> warning from SparseMeshTally::Write : cannot open "
+           << fileName << G4endl;
+    return false;
+  }
+
+  G4double size = fVoxelSize/cm;
+  file << "# sparse dose-rate mesh of the room\n"
+       << "# voxels: " << fNbVoxels[0] << " " << fNbVoxels[1] << " "
+       << fNbVoxels[2] << "\n"
+       << "# origin [cm]: " << fOrigin.x()/cm << " " << fOrigin.y()/cm
+       << " " << fOrigin.z()/cm << "\n"
+       << "# voxel size [cm]: " << size << " " << size << " " << size << "\n"
+       << "# source: " << fSourceRate << " primaries/s, "
+       << nbEvents << " events\n"
+       << "# ix,iy,iz,nFluence[cm-2 s-1],gFluence[cm-2 s-1],"
+       << "nDose[microSv/h],gDose[microSv/h]\n";
+  if (nbEvents == 0) return true;
+
+  // occupied slots, in key order
+  std::vector<const Voxel*> voxels;
+  voxels.reserve(fSize);
+  for (size_t i=0; i<fVoxels.size(); ++i) {
+    if (fVoxels[i].key != kEmpty) voxels.push_back(&fVoxels[i]);
+  }
+  std::sort(voxels.begin(), voxels.end(),
+            [](const Voxel* a, const Voxel* b) { return a->key < b->key; });
+
+  G4double fluenceNorm = fSourceRate/nbEvents/(size*size*size*cm);
+  G4double doseNorm    = fluenceNorm * 3600. * 1.e-6;
+  G4int mask = (1 << 21) - 1;
+  for (size_t i=0; i<voxels.size(); ++i) {
+    const Voxel& voxel = *voxels[i];
+    file << G4int(voxel.key >> 42) << ","
+         << (G4int(voxel.key >> 21) & mask) << ","
+         << (G4int(voxel.key) & mask) << ","
+         << voxel.length[0]*fluenceNorm << "," << voxel.length[1]*fluenceNorm
+         << "," << voxel.dose[0]*doseNorm << "," << voxel.dose[1]*doseNorm
+         << "\n";
+  }
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
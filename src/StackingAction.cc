@@ -32,14 +32,18 @@
 
 #include "StackingAction.hh"
 #include "Run.hh"
+#include "PhaseSpaceWriter.hh"
 
 #include "G4RunManager.hh"
 #include "G4Track.hh"
+#include "G4VProcess.hh"
+#include "G4Neutron.hh"
+#include "G4Gamma.hh"
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 StackingAction::StackingAction()
-:G4UserStackingAction()
+:G4UserStackingAction(), fGammaSource(0)
 { }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -56,15 +60,23 @@ StackingAction::ClassifyNewTrack(const G4Track* aTrack)
   if (aTrack->GetParentID() == 0) return fUrgent;
 
   //count secondary particles
-  G4String name   = aTrack->GetDefinition()->GetParticleName();
+  const G4ParticleDefinition* particle = aTrack->GetDefinition();
   G4double energy = aTrack->GetKineticEnergy();
   
   Run* run = static_cast<Run*>(
         G4RunManager::GetRunManager()->GetNonConstCurrentRun());    
-  run->ParticleCount(name,energy);
+  run->ParticleCount(particle,energy);
 
-  if(name =="neutron") return fUrgent; //neutrons are tracked first in the urgent stack
-  if(name == "gamma") return fWaiting; //gamma particles will be tracked in the waiting
+  if(particle == G4Neutron::Definition()) return fUrgent; //neutrons are tracked first in the urgent stack
+  if(particle == G4Gamma::Definition() && fGammaSource) {
+    //neutron phase: the gammas are written, not tracked; those of the
+    //captures and inelastic scatterings, and of any other origin too
+    fGammaSource->Push(particle->GetPDGEncoding(), aTrack->GetPosition(),
+                       aTrack->GetMomentumDirection(), energy,
+                       aTrack->GetGlobalTime(), aTrack->GetWeight());
+    return fKill;
+  }
+  if(particle == G4Gamma::Definition()) return fWaiting; //gamma particles will be tracked in the waiting
                                        //stack, after the neutrons are tracked
 
   //kill all secondaries  
@@ -33,14 +33,36 @@
 #include "SteppingAction.hh"
 #include "Run.hh"
 #include "TrackingAction.hh"
-#include "HistoManager.hh"
+#include "CrossingBuffer.hh"
+#include "AllocationCounter.hh"
+#include "CaptureBiasingOperator.hh"
+#include "PointEstimator.hh"
+#include "PhaseSpaceWriter.hh"
 
 #include "G4RunManager.hh"
+#include "G4LogicalVolumeStore.hh"
+#include "G4Neutron.hh"
+#include "G4Gamma.hh"
+
+// scored boundaries, indexed by [pre-step volume code][post-step volume code]
+//
+namespace {
+  const G4int kBoundaryTable[4][4] = {
+    // post:  other  world  room  tank
+    {         0,     0,     0,    3 },     // pre: other
+    {         0,     0,     0,    3 },     // pre: world
+    {         0,     1,     0,    3 },     // pre: room  -> world = kRoomExit
+    {         0,     2,     2,    0 }      // pre: tank  -> out   = kTankExit
+  };                                       // in  -> tank  = kTankEntry
+}
                            
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
 SteppingAction::SteppingAction(EventAction* evt, TrackingAction* TrAct)
-  : G4UserSteppingAction(),fEventAction(evt),fTrackingAction(TrAct)
+  : G4UserSteppingAction(),fEventAction(evt),fTrackingAction(TrAct),
+    fRun(0), fCrossings(0), fSurfaceTally(0), fSparseMesh(0), fPointEstimator(0),
+    fPhaseSpace(0), fKillTankEntries(false), fNeutron(0), fGamma(0),
+    fHasRoulette(false)
 {
   //get the dedector
   fDetector = static_cast<const DetectorConstruction*> (G4RunManager::GetRunManager()->GetUserDetectorConstruction());
@@ -54,74 +76,201 @@ SteppingAction::~SteppingAction()
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
+void SteppingAction::BeginOfRun(Run* run, CrossingBuffer* crossings,
+                                PointEstimator* points, PhaseSpaceBuffer* phaseSpace,
+                                G4bool killTankEntries)
+{
+  fRun = run;
+  fCrossings = crossings;
+  fPointEstimator = points;
+  fPhaseSpace = phaseSpace;
+  fKillTankEntries = killTankEntries;
+  fSurfaceTally = run->GetSurfaceTally()->IsBooked() ? run->GetSurfaceTally() : 0;
+  fSparseMesh   = run->GetSparseMesh()->IsBooked()   ? run->GetSparseMesh()   : 0;
+  fNeutron = G4Neutron::Definition();
+  fGamma   = G4Gamma::Definition();
+
+  // the geometry may have been rebuilt since the previous run
+  //
+  const G4LogicalVolumeStore* store = G4LogicalVolumeStore::GetInstance();
+  G4int maxId = 0;
+  for (size_t i=0; i<store->size(); ++i) {
+    G4int id = (*store)[i]->GetInstanceID();
+    if (id > maxId) maxId = id;
+  }
+  fVolumeCode.assign(maxId+1, kOtherVolume);
+  fVolumeCode[fDetector->worldL->GetInstanceID()] = kWorldVolume;
+  fVolumeCode[fDetector->roomL->GetInstanceID()]  = kRoomVolume;
+  // the gaps reach the faces of the tank: leaving one leaves the tank
+  SetVolumeCode(fDetector->GetTankVolume(), kTankVolume, true);
+
+  // volumes under implicit capture, attached by the physics at this run
+  //
+  fRoulette.assign(maxId+1, 0);
+  fHasRoulette = false;
+  for (size_t i=0; i<store->size(); ++i) {
+    const G4LogicalVolume* volume = (*store)[i];
+    const CaptureBiasingOperator* op = dynamic_cast<const CaptureBiasingOperator*>
+                               (G4VBiasingOperator::GetBiasingOperator(volume));
+    if (op && op->HasImplicitCapture(volume)) {
+      fRoulette[volume->GetInstanceID()] = op;
+      fHasRoulette = true;
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SteppingAction::SetVolumeCode(const G4LogicalVolume* lv, G4int code,
+                                   G4bool daughters)
+{
+  fVolumeCode[lv->GetInstanceID()] = code;
+  if (!daughters) return;
+  for (G4int i=0; i<lv->GetNoDaughters(); ++i) {
+    SetVolumeCode(lv->GetDaughter(i)->GetLogicalVolume(), code, true);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+inline G4int SteppingAction::GetVolumeCode(const G4LogicalVolume* lv) const
+{
+  size_t id = lv->GetInstanceID();
+  return (id < fVolumeCode.size()) ? fVolumeCode[id] : G4int(kOtherVolume);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
 void SteppingAction::UserSteppingAction(const G4Step* step)
 {
+#ifdef MONITOR_COUNT_ALLOCATIONS
+  size_t nbAlloc = AllocationCounter::GetCount();
+  ScoreStep(step);
+  fRun->CountStepAllocations(AllocationCounter::GetCount() - nbAlloc);
+#else
+  ScoreStep(step);
+#endif
+  if (fPointEstimator) ScorePoints(step);
+  if (fHasRoulette) PlayRoulette(step);
+}
 
-  //Get process information
-  const G4StepPoint* endPoint = step->GetPostStepPoint();
-  const G4VProcess* process = endPoint->GetProcessDefinedStep();
-  G4String processName = process->GetProcessName();
-  
-  // count processes
-  Run* run = static_cast<Run*>(G4RunManager::GetRunManager()->GetNonConstCurrentRun());
-  run->CountProcesses(process);
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-  // Get step information
-  const G4StepPoint* pre = step->GetPreStepPoint();
+void SteppingAction::ScorePoints(const G4Step* step)
+{
+  const G4Track* track = step->GetTrack();
+  const G4ParticleDefinition* particle = track->GetDefinition();
+  G4int particleCode;
+  if      (particle == fNeutron) particleCode = CrossingRecord::kNeutron;
+  else if (particle == fGamma)   particleCode = CrossingRecord::kGamma;
+  else return;
+
+  // emission: first step of a primary or of a secondary of an interaction;
+  // the clones of the splitting processes are not new emissions. The
+  // weight of a primary only corrects its biased direction: the source
+  // emits isotropically with unit weight
+  if (track->GetCurrentStepNumber() == 1) {
+    const G4VProcess* creator = track->GetCreatorProcess();
+    G4ProcessType type = creator ? creator->GetProcessType() : fHadronic;
+    if (type == fHadronic || type == fElectromagnetic || type == fDecay) {
+      const G4StepPoint* pre = step->GetPreStepPoint();
+      fPointEstimator->ScoreEmission(particleCode, creator, pre->GetPosition(),
+                                     pre->GetKineticEnergy(),
+                                     creator ? pre->GetWeight() : 1.);
+    }
+  }
+
+  // collision: an interaction the particle survives, scored with the
+  // angular law of the process from the direction and energy before it
+  // (neutrons and gammas lose no energy along the step)
   const G4StepPoint* post = step->GetPostStepPoint();
-  const G4VPhysicalVolume* prePhysical = pre->GetPhysicalVolume();
-  const G4VPhysicalVolume* postPhysical = post->GetPhysicalVolume();
-  G4double x = post->GetPosition().x(), y = post->GetPosition().y(), z = post->GetPosition().z(); 	
+  if (post->GetStepStatus() != fPostStepDoItProc
+      || track->GetTrackStatus() != fAlive) return;
+  const G4StepPoint* pre = step->GetPreStepPoint();
+  fPointEstimator->ScoreCollision(particleCode, post->GetProcessDefinedStep(),
+                                  post->GetPosition(),
+                                  pre->GetMomentumDirection(),
+                                  pre->GetKineticEnergy(), post->GetWeight());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
 
-  // Get track information
+void SteppingAction::PlayRoulette(const G4Step* step)
+{
+  // weight cutoff of the neutrons under implicit capture, once scored
   G4Track* track = step->GetTrack();
-  G4double ekin  = endPoint->GetKineticEnergy();
-  G4double trackl = step->GetTrack()->GetTrackLength();
-  G4double time   = step->GetTrack()->GetLocalTime();
+  if (track->GetDefinition() != fNeutron
+      || track->GetTrackStatus() != fAlive) return;
+  size_t id = step->GetPreStepPoint()->GetPhysicalVolume()
+                  ->GetLogicalVolume()->GetInstanceID();
+  if (id < fRoulette.size() && fRoulette[id]) fRoulette[id]->PlayRoulette(track);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SteppingAction::ScoreStep(const G4Step* step)
+{
+  // count processes
+  const G4StepPoint* post = step->GetPostStepPoint();
+  fRun->CountProcesses(post->GetProcessDefinedStep());
+
+  // only neutrons and gammas are scored: every step in the sparse mesh,
+  // boundary crossings otherwise; the phase space of the tank keeps all,
+  // and so does its replay, which kills any particle entering the tank
+  G4bool onBoundary = (post->GetStepStatus() == fGeomBoundary);
+  if (!onBoundary && !fSparseMesh) return;
+
+  const G4ParticleDefinition* particle = step->GetTrack()->GetDefinition();
+  G4int particleCode = -1;
+  if      (particle == fNeutron) particleCode = CrossingRecord::kNeutron;
+  else if (particle == fGamma)   particleCode = CrossingRecord::kGamma;
+  else if (!onBoundary || !(fPhaseSpace || fKillTankEntries)) return;
+
+  if (fSparseMesh && particleCode >= 0) {
+    const G4StepPoint* pre = step->GetPreStepPoint();
+    fSparseMesh->ScoreSegment(particleCode, pre->GetPosition(),
+                              post->GetPosition(), pre->GetKineticEnergy(),
+                              pre->GetWeight());
+  }
+  if (!onBoundary) return;
 
   // Sanity checks
+  const G4VPhysicalVolume* prePhysical = step->GetPreStepPoint()->GetPhysicalVolume();
+  const G4VPhysicalVolume* postPhysical = post->GetPhysicalVolume();
   if(prePhysical == 0 || postPhysical == 0) return;  // The track does not exist  
-  if(prePhysical->GetCopyNo() == -1 && postPhysical->GetCopyNo() == -1) return; // Both steps are in the World
-  
-  // Get logical volume
-  const G4LogicalVolume* preLogical = pre->GetTouchableHandle()->GetVolume()->GetLogicalVolume();
-  const G4LogicalVolume* postLogical = post->GetTouchableHandle()->GetVolume()->GetLogicalVolume();
-  	
-  // Get particle name
-  G4String particleName = step->GetTrack()->GetDefinition()->GetParticleName();
-
-  //Neutron passing through boundary
-  if(particleName == "neutron" && post->GetStepStatus() == fGeomBoundary) {
-
-       
-    //neutrons leaving the lab
-    if(preLogical == fDetector->roomL &&
-       postLogical == fDetector->worldL){
-      G4AnalysisManager::Instance()->FillNtupleDColumn(0,0,x/1000); //ID, column,value
-      G4AnalysisManager::Instance()->FillNtupleDColumn(0,1,y/1000); //ID, column,value
-      G4AnalysisManager::Instance()->FillNtupleDColumn(0,2,z/1000); //ID, column,value
-      G4AnalysisManager::Instance()->FillNtupleDColumn(0,3,ekin); 
-      G4AnalysisManager::Instance()->AddNtupleRow(0);
+
+  G4int boundary = kBoundaryTable[GetVolumeCode(prePhysical->GetLogicalVolume())]
+                                 [GetVolumeCode(postPhysical->GetLogicalVolume())];
+
+  //any particle leaving the tank: surface source of the later runs
+  if (boundary == kTankExit) {
+    if (fPhaseSpace) {
+      fPhaseSpace->Push(particle->GetPDGEncoding(), post->GetPosition(),
+                        post->GetMomentumDirection(), post->GetKineticEnergy(),
+                        post->GetGlobalTime(), post->GetWeight());
     }
+    return;
   }
 
-  
-  //Gamma passing through boundary
-  if(particleName == "gamma" && post->GetStepStatus() == fGeomBoundary) {
-
-    //gamma leaving the lab
-    if(preLogical == fDetector->roomL &&
-       postLogical == fDetector->worldL){
-      G4AnalysisManager::Instance()->FillH1(1,ekin);
-      G4AnalysisManager::Instance()->FillNtupleDColumn(1,0,x/1000); //ID, column,value
-      G4AnalysisManager::Instance()->FillNtupleDColumn(1,1,y/1000); //ID, column,value
-      G4AnalysisManager::Instance()->FillNtupleDColumn(1,2,z/1000); //ID, column,value
-      G4AnalysisManager::Instance()->FillNtupleDColumn(1,3,ekin); 
-      G4AnalysisManager::Instance()->AddNtupleRow(1);
-    }
+  //replay of the tank exits: a particle coming back into the tank is
+  //dropped, the file holding its later exits as records of their own
+  if (boundary == kTankEntry) {
+    if (fKillTankEntries) step->GetTrack()->SetTrackStatus(fStopAndKill);
+    return;
+  }
+  if (boundary != kRoomExit || particleCode < 0) return;
+
+  //neutrons and gammas leaving the lab
+  const G4ThreeVector& position = post->GetPosition();
+  if (fSurfaceTally) {
+    fSurfaceTally->Score(particleCode, position, post->GetMomentumDirection(),
+                         post->GetKineticEnergy(), post->GetWeight());
+  }
+  if (fCrossings) {
+    fCrossings->Push(particleCode,
+                     position.x()/1000, position.y()/1000, position.z()/1000,
+                     post->GetKineticEnergy(), post->GetWeight());
   }
 }
 
 //....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
-
-
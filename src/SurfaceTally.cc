@@ -0,0 +1,277 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file SurfaceTally.cc
+/// \brief Implementation of the SurfaceTally class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "SurfaceTally.hh"
+#include "CrossingBuffer.hh"
+#include "FluenceToDose.hh"
+
+#include "G4SystemOfUnits.hh"
+#include "G4UnitsTable.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+SurfaceTally::SurfaceTally()
+  : fBinSize(10*cm), fSourceRate(1.e8), fDose(0), fNbBins(0)
+{
+  for (G4int k=0; k<kNbFaces; ++k) {
+    FaceLayout& face = fFace[k];
+    face.axis = face.uAxis = face.vAxis = 0;
+    face.uMin = face.vMin = 0.;
+    face.nbU  = face.nbV  = 0;
+    face.offset = 0;
+  }
+  for (G4int p=0; p<kNbParticles; ++p) {
+    for (G4int k=0; k<kNbFaces; ++k) fEventSum[p][k] = fSum1[p][k] = fSum2[p][k] = 0.;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+SurfaceTally::~SurfaceTally()
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+const char* SurfaceTally::GetFaceName(G4int face)
+{
+  static const char* name[kNbFaces] =
+    { "North", "East", "South", "West", "Ceiling" };
+  return name[face];
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SurfaceTally::Book(const G4ThreeVector& roomCenter,
+                        const G4ThreeVector& roomSize)
+{
+  fCenter   = roomCenter;
+  fHalfSize = 0.5*roomSize;
+
+  // normal axis and (u,v) axes of each face: East/West walls are
+  // (y,z) maps, North/South walls (x,z) maps, the ceiling a (x,y) map
+  const G4int axes[kNbFaces][3] = {
+    {1, 0, 2}, {0, 1, 2}, {1, 0, 2}, {0, 1, 2}, {2, 0, 1} };
+
+  fNbBins = 0;
+  for (G4int k=0; k<kNbFaces; ++k) {
+    FaceLayout& face = fFace[k];
+    face.axis  = axes[k][0];
+    face.uAxis = axes[k][1];
+    face.vAxis = axes[k][2];
+    face.uMin  = fCenter[face.uAxis] - fHalfSize[face.uAxis];
+    face.vMin  = fCenter[face.vAxis] - fHalfSize[face.vAxis];
+    face.nbU   = std::max(1, G4int(std::ceil(roomSize[face.uAxis]/fBinSize)));
+    face.nbV   = std::max(1, G4int(std::ceil(roomSize[face.vAxis]/fBinSize)));
+    face.offset = fNbBins;
+    fNbBins += face.nbU*face.nbV;
+  }
+  fSum.assign(kNbParticles*fNbBins, 0.);
+  for (G4int p=0; p<kNbParticles; ++p) {
+    for (G4int k=0; k<kNbFaces; ++k) fEventSum[p][k] = fSum1[p][k] = fSum2[p][k] = 0.;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double SurfaceTally::GetUMax(G4int face) const
+{
+  return fFace[face].uMin + fFace[face].nbU*fBinSize;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double SurfaceTally::GetVMax(G4int face) const
+{
+  return fFace[face].vMin + fFace[face].nbV*fBinSize;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SurfaceTally::Score(G4int particle, const G4ThreeVector& position,
+                         const G4ThreeVector& direction, G4double energy,
+                         G4double weight)
+{
+  // the face crossed is the one the exit point is closest to, relative
+  // to the room half sizes
+  G4ThreeVector local = position - fCenter;
+  G4int axis = 0;
+  G4double ratio = std::fabs(local.x())/fHalfSize.x();
+  for (G4int i=1; i<3; ++i) {
+    G4double r = std::fabs(local[i])/fHalfSize[i];
+    if (r > ratio) { ratio = r; axis = i; }
+  }
+
+  G4int face;
+  if      (axis == 0) face = (local.x() > 0.) ? kEast  : kWest;
+  else if (axis == 1) face = (local.y() > 0.) ? kNorth : kSouth;
+  else if (local.z() > 0.) face = kCeiling;
+  else return;                                      //floor
+
+  const FaceLayout& layout = fFace[face];
+  G4int iu = G4int((position[layout.uAxis] - layout.uMin)/fBinSize);
+  G4int iv = G4int((position[layout.vAxis] - layout.vMin)/fBinSize);
+  iu = std::min(std::max(iu, 0), layout.nbU-1);
+  iv = std::min(std::max(iv, 0), layout.nbV-1);
+
+  // fluence = sum w/|cos| / area; below |cos| = 0.1 the grazing crossings
+  // are scored with cos = 0.05, the mean of 1/|cos| over that range being
+  // unbounded (MCNP surface flux)
+  G4double cosine = std::fabs(direction[layout.axis]);
+  if (cosine < 0.1) cosine = 0.05;
+
+  G4double dose = weight*fDose->GetCoefficient(particle, energy)/cosine;
+  Sums(particle)[layout.offset + iv*layout.nbU + iu] += dose;
+  fEventSum[particle][face] += dose;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SurfaceTally::EndOfEvent()
+{
+  for (G4int p=0; p<kNbParticles; ++p) {
+    for (G4int k=0; k<kNbFaces; ++k) {
+      G4double x = fEventSum[p][k];
+      if (x == 0.) continue;
+      fSum1[p][k] += x;
+      fSum2[p][k] += x*x;
+      fEventSum[p][k] = 0.;
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SurfaceTally::Merge(const SurfaceTally& other)
+{
+  if (other.fSum.size() != fSum.size()) {
+    G4cout << "\n--> warning from SurfaceTally::Merge : "
+           << "binning differs between threads, tally not merged" << G4endl;
+    return;
+  }
+  const G4double* sum = other.fSum.data();
+  for (size_t i=0; i<fSum.size(); ++i) fSum[i] += sum[i];
+  for (G4int p=0; p<kNbParticles; ++p) {
+    for (G4int k=0; k<kNbFaces; ++k) {
+      fSum1[p][k] += other.fSum1[p][k];
+      fSum2[p][k] += other.fSum2[p][k];
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4double SurfaceTally::GetDoseRate(G4int particle, G4int face,
+                                   G4int iu, G4int iv, G4int nbEvents) const
+{
+  if (nbEvents == 0) return 0.;
+  const FaceLayout& layout = fFace[face];
+  G4double sum = Sums(particle)[layout.offset + iv*layout.nbU + iu];
+
+  // pSv per primary -> microSv/h at the source rate
+  G4double area = fBinSize*fBinSize/cm2;
+  return sum/area * fSourceRate/nbEvents * 3600. * 1.e-6;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SurfaceTally::Print(G4int nbEvents) const
+{
+  if (!IsBooked() || nbEvents == 0) return;
+
+  const char* particleName[kNbParticles] = { "neutron", "gamma" };
+
+  G4int dfprec = G4cout.precision(4);
+  G4cout << "\n Dose rate on the lab walls (microSv/h, "
+         << G4BestUnit(fBinSize,"Length") << "bins, "
+         << fSourceRate << " primaries/s)" << G4endl;
+  for (G4int p=0; p<kNbParticles; ++p) {
+    G4cout << "  " << std::setw(8) << particleName[p] << " dose: "
+           << fDose->GetTableName(p) << G4endl;
+  }
+
+  for (G4int p=0; p<kNbParticles; ++p) {
+    for (G4int k=0; k<kNbFaces; ++k) {
+      const FaceLayout& layout = fFace[k];
+      G4double peak = 0., mean = 0.;
+      G4int iuPeak = 0, ivPeak = 0;
+      for (G4int iv=0; iv<layout.nbV; ++iv) {
+        for (G4int iu=0; iu<layout.nbU; ++iu) {
+          G4double rate = GetDoseRate(p, k, iu, iv, nbEvents);
+          mean += rate;
+          if (rate > peak) { peak = rate; iuPeak = iu; ivPeak = iv; }
+        }
+      }
+      mean /= layout.nbU*layout.nbV;
+      G4cout << "  " << std::setw(8) << particleName[p]
+             << std::setw(9) << GetFaceName(k)
+             << ": mean = " << std::setw(10) << mean
+             << "  peak = " << std::setw(10) << peak
+             << "  at (" << G4BestUnit(layout.uMin + (iuPeak+0.5)*fBinSize,"Length")
+             << ", "     << G4BestUnit(layout.vMin + (ivPeak+0.5)*fBinSize,"Length")
+             << ")" << G4endl;
+    }
+  }
+  G4cout.precision(dfprec);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void SurfaceTally::PrintFigureOfMerit(G4int nbEvents, G4double time) const
+{
+  if (!IsBooked() || nbEvents == 0) return;
+
+  const char* particleName[kNbParticles] = { "neutron", "gamma" };
+
+  // R^2 = sum x^2/(sum x)^2 - 1/N for the per-event doses x of a face
+  G4int dfprec = G4cout.precision(4);
+  G4cout << "\n Figure of merit of the lab-wall doses (" << nbEvents
+         << " events in " << time << " s)" << G4endl;
+  for (G4int p=0; p<kNbParticles; ++p) {
+    for (G4int k=0; k<kNbFaces; ++k) {
+      G4double sum1 = fSum1[p][k], sum2 = fSum2[p][k];
+      G4cout << "  " << std::setw(8) << particleName[p]
+             << std::setw(9) << GetFaceName(k) << ": ";
+      if (sum1 <= 0.) { G4cout << "no score" << G4endl; continue; }
+      G4double r2 = std::max(sum2/(sum1*sum1) - 1./nbEvents, 0.);
+      G4cout << "R = " << std::setw(10) << std::sqrt(r2);
+      if (r2 > 0. && time > 0.) G4cout << "  FOM = " << 1./(r2*time) << " /s";
+      G4cout << G4endl;
+    }
+  }
+  G4cout.precision(dfprec);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,192 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file ThreadAffinity.cc
+/// \brief Implementation of the ThreadAffinity class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "ThreadAffinity.hh"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ThreadAffinity::ThreadAffinity(const G4String& policy)
+  : fPolicy(policy), fNbNodes(1)
+{
+  ReadTopology();
+  G4int nbCpus = fNodeOfCpu.size();
+
+  if (policy == "compact" || policy == "scatter") {
+    // CPUs of each node, in increasing number
+    std::vector<std::vector<G4int> > nodeCpus(fNbNodes);
+    for (G4int cpu=0; cpu<nbCpus; ++cpu) {
+      if (fNodeOfCpu[cpu] >= 0) nodeCpus[fNodeOfCpu[cpu]].push_back(cpu);
+    }
+    if (policy == "compact") {
+      for (G4int n=0; n<fNbNodes; ++n) {
+        fCpus.insert(fCpus.end(), nodeCpus[n].begin(), nodeCpus[n].end());
+      }
+    } else {
+      for (size_t k=0; fCpus.size() < size_t(nbCpus) && k < size_t(nbCpus); ++k) {
+        for (G4int n=0; n<fNbNodes; ++n) {
+          if (k < nodeCpus[n].size()) fCpus.push_back(nodeCpus[n][k]);
+        }
+      }
+    }
+  }
+  else {
+    std::vector<G4int> list = ParseList(policy);
+    for (size_t i=0; i<list.size(); ++i) {
+      if (list[i] >= 0 && list[i] < nbCpus && fNodeOfCpu[list[i]] >= 0) {
+        fCpus.push_back(list[i]);
+      }
+    }
+  }
+
+  if (fCpus.empty()) {
+    G4cout << "\n--> warning from ThreadAffinity : no CPU for '" << policy
+           << "', the threads are not pinned" << G4endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+ThreadAffinity::~ThreadAffinity()
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+std::vector<G4int> ThreadAffinity::ParseList(const G4String& text)
+{
+  // e.g. 0-3,8,10-11
+  std::vector<G4int> list;
+  if (text.find_first_not_of("0123456789-,\n") != std::string::npos) return list;
+  std::string item;
+  std::istringstream is(text);
+  while (std::getline(is, item, ',')) {
+    if (item.empty()) continue;
+    size_t dash = item.find('-');
+    G4int first = std::atoi(item.substr(0, dash).c_str());
+    G4int last  = (dash == std::string::npos) ? first
+                : std::atoi(item.substr(dash+1).c_str());
+    for (G4int cpu=first; cpu<=last; ++cpu) list.push_back(cpu);
+  }
+  return list;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ThreadAffinity::ReadTopology()
+{
+  // online CPUs, then the CPUs of each NUMA node
+  std::string line;
+  std::ifstream online("/sys/devices/system/cpu/online");
+  std::vector<G4int> cpus;
+  if (online && std::getline(online, line)) cpus = ParseList(line);
+  if (cpus.empty()) return;
+  fNodeOfCpu.assign(*std::max_element(cpus.begin(), cpus.end()) + 1, -1);
+  for (size_t i=0; i<cpus.size(); ++i) fNodeOfCpu[cpus[i]] = 0;
+
+  fNbNodes = 1;
+  for (G4int node=0; ; ++node) {
+    std::ostringstream name;
+    name << "/sys/devices/system/node/node" << node << "/cpulist";
+    std::ifstream file(name.str().c_str());
+    if (!file || !std::getline(file, line)) break;
+    std::vector<G4int> nodeCpus = ParseList(line);
+    for (size_t i=0; i<nodeCpus.size(); ++i) {
+      G4int cpu = nodeCpus[i];
+      if (cpu < G4int(fNodeOfCpu.size()) && fNodeOfCpu[cpu] >= 0) {
+        fNodeOfCpu[cpu] = node;
+      }
+    }
+    fNbNodes = node + 1;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int ThreadAffinity::GetCpu(G4int thread) const
+{
+  if (fCpus.empty() || thread < 0) return -1;
+  return fCpus[thread % fCpus.size()];
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4int ThreadAffinity::GetNode(G4int thread) const
+{
+  G4int cpu = GetCpu(thread);
+  return (cpu < 0) ? 0 : fNodeOfCpu[cpu];
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool ThreadAffinity::Pin(G4int thread) const
+{
+  G4int cpu = GetCpu(thread);
+  if (cpu < 0) return false;
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+  return false;
+#endif
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void ThreadAffinity::Print(G4int nbThreads) const
+{
+  if (fCpus.empty()) return;
+  G4cout << "\n Thread affinity " << fPolicy << " (" << fNbNodes
+         << " NUMA nodes):";
+  for (G4int i=0; i<nbThreads; ++i) {
+    if (i%8 == 0) G4cout << "\n  ";
+    G4cout << " " << i << "->" << GetCpu(i) << "/" << GetNode(i);
+  }
+  G4cout << "\n   (thread->cpu/node)" << G4endl;
+  if (nbThreads > G4int(fCpus.size())) {
+    G4cout << "\n--> warning from ThreadAffinity : " << nbThreads
+           << " threads on " << fCpus.size() << " CPUs" << G4endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,162 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file WeightWindowMessenger.cc
+/// \brief Implementation of the WeightWindowMessenger class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "WeightWindowMessenger.hh"
+
+#include "WeightWindowWorld.hh"
+
+#include "G4UIdirectory.hh"
+#include "G4UIcommand.hh"
+#include "G4UIparameter.hh"
+#include "G4UIcmdWithAString.hh"
+#include "G4UIcmdWithAnInteger.hh"
+#include "G4UIcmdWithADouble.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+WeightWindowMessenger::WeightWindowMessenger(WeightWindowWorld* world)
+:G4UImessenger(), fWorld(world),
+ fWindowDir(0), fMeshCmd(0), fLoadCmd(0), fGenerateCmd(0), fUpperCmd(0),
+ fSurvivalCmd(0), fMaxSplitsCmd(0), fPlaceCmd(0)
+{
+  // the windows live in the (shared) parallel world: master only
+  G4bool broadcast = false;
+  fWindowDir = new G4UIdirectory("/testhadr/bias/ww/",broadcast);
+  fWindowDir->SetGuidance("weight windows on a mesh over the room");
+
+  fMeshCmd = new G4UIcommand("/testhadr/bias/ww/setMesh",this);
+  fMeshCmd->SetGuidance("Weight-window mesh over the room, in a parallel");
+  fMeshCmd->SetGuidance("world: nb of cells along x, y, z.");
+  fMeshCmd->SetGuidance("0 0 0 : no mesh (default)");
+  //
+  const char* axis[] = { "nx", "ny", "nz" };
+  for (G4int i=0; i<3; ++i) {
+    G4UIparameter* nbPrm = new G4UIparameter(axis[i],'i',false);
+    nbPrm->SetGuidance("nb of cells");
+    nbPrm->SetParameterRange(G4String(axis[i]) + ">=0");
+    fMeshCmd->SetParameter(nbPrm);
+  }
+  //
+  fMeshCmd->AvailableForStates(G4State_PreInit);
+
+  fLoadCmd = new G4UIcmdWithAString("/testhadr/bias/ww/load",this);
+  fLoadCmd->SetGuidance("Read the weight windows of the mesh from a file");
+  fLoadCmd->SetGuidance("written by a pilot run; switches the biasing on.");
+  fLoadCmd->SetParameterName("fileName",false);
+  fLoadCmd->AvailableForStates(G4State_PreInit);
+
+  fGenerateCmd = new G4UIcmdWithAString("/testhadr/bias/ww/generate",this);
+  fGenerateCmd->SetGuidance("The next runs are pilot runs: the neutron fluence");
+  fGenerateCmd->SetGuidance("of the mesh cells gives the weight windows,");
+  fGenerateCmd->SetGuidance("written to the file at end of run.");
+  fGenerateCmd->SetGuidance("none : no generation (default)");
+  fGenerateCmd->SetParameterName("fileName",false);
+  fGenerateCmd->AvailableForStates(G4State_PreInit,G4State_Idle);
+
+  fUpperCmd = new G4UIcmdWithADouble("/testhadr/bias/ww/upperFactor",this);
+  fUpperCmd->SetGuidance("Upper bound of the windows / lower bound (default 5)");
+  fUpperCmd->SetParameterName("factor",false);
+  fUpperCmd->SetRange("factor>1.");
+  fUpperCmd->AvailableForStates(G4State_PreInit);
+
+  fSurvivalCmd = new G4UIcmdWithADouble("/testhadr/bias/ww/survivalFactor",this);
+  fSurvivalCmd->SetGuidance("Weight of the roulette survivors / lower bound");
+  fSurvivalCmd->SetGuidance("(default 3); also used to generate the windows");
+  fSurvivalCmd->SetParameterName("factor",false);
+  fSurvivalCmd->SetRange("factor>=1.");
+  fSurvivalCmd->AvailableForStates(G4State_PreInit);
+
+  fMaxSplitsCmd = new G4UIcmdWithAnInteger("/testhadr/bias/ww/maxSplits",this);
+  fMaxSplitsCmd->SetGuidance("Largest nb of copies of a split track (default 5)");
+  fMaxSplitsCmd->SetParameterName("nbSplits",false);
+  fMaxSplitsCmd->SetRange("nbSplits>=2");
+  fMaxSplitsCmd->AvailableForStates(G4State_PreInit);
+
+  fPlaceCmd = new G4UIcmdWithAString("/testhadr/bias/ww/placeOfAction",this);
+  fPlaceCmd->SetGuidance("Apply the windows at cell boundaries, collisions");
+  fPlaceCmd->SetGuidance("or both (default)");
+  fPlaceCmd->SetParameterName("place",false);
+  fPlaceCmd->SetCandidates("boundary collision both");
+  fPlaceCmd->AvailableForStates(G4State_PreInit);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+WeightWindowMessenger::~WeightWindowMessenger()
+{
+  delete fMeshCmd;
+  delete fLoadCmd;
+  delete fGenerateCmd;
+  delete fUpperCmd;
+  delete fSurvivalCmd;
+  delete fMaxSplitsCmd;
+  delete fPlaceCmd;
+  delete fWindowDir;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void WeightWindowMessenger::SetNewValue(G4UIcommand* command, G4String newValue)
+{
+  if (command == fMeshCmd)
+   {
+     G4int nx, ny, nz;
+     std::istringstream is(newValue);
+     is >> nx >> ny >> nz;
+     fWorld->SetNbCells(nx,ny,nz);
+   }
+
+  if (command == fLoadCmd)
+   { fWorld->LoadWindows(newValue); }
+
+  if (command == fGenerateCmd)
+   { fWorld->SetGenerationFile(newValue == "none" ? G4String("") : newValue); }
+
+  if (command == fUpperCmd)
+   { fWorld->SetUpperFactor(fUpperCmd->GetNewDoubleValue(newValue)); }
+
+  if (command == fSurvivalCmd)
+   { fWorld->SetSurvivalFactor(fSurvivalCmd->GetNewDoubleValue(newValue)); }
+
+  if (command == fMaxSplitsCmd)
+   { fWorld->SetMaxSplits(fMaxSplitsCmd->GetNewIntValue(newValue)); }
+
+  if (command == fPlaceCmd)
+   {
+     if      (newValue == "boundary")  fWorld->SetPlaceOfAction(onBoundary);
+     else if (newValue == "collision") fWorld->SetPlaceOfAction(onCollision);
+     else                              fWorld->SetPlaceOfAction(onBoundaryAndCollision);
+   }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,86 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file WeightWindowPhysics.cc
+/// \brief Implementation of the WeightWindowPhysics class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "WeightWindowPhysics.hh"
+#include "WeightWindowWorld.hh"
+
+#include "G4GeometrySampler.hh"
+#include "G4WeightWindowAlgorithm.hh"
+#include "G4WeightWindowBiasing.hh"
+#include "G4ParallelWorldPhysics.hh"
+#include "G4TransportationManager.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+WeightWindowPhysics::WeightWindowPhysics(WeightWindowWorld* world)
+  : G4VPhysicsConstructor("WeightWindowBiasing"), fWorld(world),
+    fParallelWorld(0), fSampler(0), fAlgorithm(0), fBiasing(0)
+{
+  fSampler = new G4GeometrySampler(0, "neutron");
+  fSampler->SetParallel(true);
+  fParallelWorld = new G4ParallelWorldPhysics(fWorld->GetName());
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+WeightWindowPhysics::~WeightWindowPhysics()
+{
+  delete fBiasing;
+  delete fAlgorithm;
+  delete fSampler;
+  delete fParallelWorld;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void WeightWindowPhysics::ConstructProcess()
+{
+  if (!fWorld->HasMesh()) return;
+
+  if (fWorld->HasWindows()) {
+    if (!fBiasing) {
+      fAlgorithm = new G4WeightWindowAlgorithm(fWorld->GetUpperFactor(),
+                                               fWorld->GetSurvivalFactor(),
+                                               fWorld->GetMaxSplits());
+      fBiasing = new G4WeightWindowBiasing(fSampler, fAlgorithm,
+                                           fWorld->GetPlaceOfAction(),
+                                           fWorld->GetName());
+    }
+    fSampler->SetWorld(G4TransportationManager::GetTransportationManager()
+                       ->GetParallelWorld(fWorld->GetName()));
+    fBiasing->ConstructProcess();
+  }
+  fParallelWorld->ConstructProcess();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
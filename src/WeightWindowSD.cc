@@ -0,0 +1,75 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file WeightWindowSD.cc
+/// \brief Implementation of the WeightWindowSD class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "WeightWindowSD.hh"
+#include "WindowFluxTally.hh"
+
+#include "G4Step.hh"
+#include "G4Neutron.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+WeightWindowSD::WeightWindowSD(const G4String& name)
+  : G4VSensitiveDetector(name), fFlux(0), fNeutron(G4Neutron::Definition())
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+WeightWindowSD::~WeightWindowSD()
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void WeightWindowSD::BeginOfRun(WindowFluxTally* flux)
+{
+  fFlux = (flux && flux->IsBooked()) ? flux : 0;
+  Activate(fFlux != 0);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool WeightWindowSD::ProcessHits(G4Step* step, G4TouchableHistory*)
+{
+  if (!fFlux || step->GetTrack()->GetDefinition() != fNeutron) return false;
+
+  G4double length = step->GetStepLength();
+  if (length <= 0.) return false;
+
+  // the copy number of the cell is its index
+  const G4StepPoint* pre = step->GetPreStepPoint();
+  fFlux->Score(pre->GetTouchable()->GetCopyNumber(), pre->GetKineticEnergy(),
+               pre->GetWeight()*length);
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,322 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file WeightWindowWorld.cc
+/// \brief Implementation of the WeightWindowWorld class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "WeightWindowWorld.hh"
+#include "WeightWindowMessenger.hh"
+#include "WeightWindowSD.hh"
+#include "WindowFluxTally.hh"
+#include "DetectorConstruction.hh"
+
+#include "G4Box.hh"
+#include "G4LogicalVolume.hh"
+#include "G4PVPlacement.hh"
+#include "G4SDManager.hh"
+#include "G4WeightWindowStore.hh"
+#include "G4SystemOfUnits.hh"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+WeightWindowWorld::WeightWindowWorld(const G4String& worldName,
+                                     DetectorConstruction* det)
+  : G4VUserParallelWorld(worldName), fDetector(det), fMessenger(0),
+    fCellL(0), fWorldP(0), fMeshP(0),
+    fUpperFactor(5.), fSurvivalFactor(3.), fMaxSplits(5),
+    fPlace(onBoundaryAndCollision), fGenerationFile("")
+{
+  fNbCells[0] = fNbCells[1] = fNbCells[2] = 0;
+  fMessenger = new WeightWindowMessenger(this);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+WeightWindowWorld::~WeightWindowWorld()
+{ delete fMessenger; }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void WeightWindowWorld::SetNbCells(G4int nx, G4int ny, G4int nz)
+{
+  fNbCells[0] = nx;
+  fNbCells[1] = ny;
+  fNbCells[2] = nz;
+  fLowerWeight.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void WeightWindowWorld::Construct()
+{
+  if (!HasMesh()) return;
+
+  fWorldP = GetWorld();
+
+  // the mesh covers the room of the mass geometry, tank included
+  G4ThreeVector center = fDetector->GetRoomCenter();
+  G4ThreeVector size   = fDetector->GetRoomSize();
+  G4int nx = fNbCells[0], ny = fNbCells[1], nz = fNbCells[2];
+  fCellSize = G4ThreeVector(size.x()/nx, size.y()/ny, size.z()/nz);
+  fOrigin   = center - 0.5*size;
+
+  G4Box* meshS = new G4Box("WindowMesh", size.x()/2, size.y()/2, size.z()/2);
+  G4LogicalVolume* meshL = new G4LogicalVolume(meshS, 0, "WindowMesh");
+  fMeshP = new G4PVPlacement(0, center, meshL, "WindowMesh",
+                             fWorldP->GetLogicalVolume(), false, 0);
+
+  // one placement per cell, its copy number being the cell index
+  G4Box* cellS = new G4Box("WindowCell", fCellSize.x()/2, fCellSize.y()/2,
+                           fCellSize.z()/2);
+  fCellL = new G4LogicalVolume(cellS, 0, "WindowCell");
+  fCell.assign(GetNbCells(), 0);
+  for (G4int ix=0; ix<nx; ++ix) {
+    for (G4int iy=0; iy<ny; ++iy) {
+      for (G4int iz=0; iz<nz; ++iz) {
+        G4int cell = (ix*ny + iy)*nz + iz;
+        G4ThreeVector position((ix+0.5)*fCellSize.x() - 0.5*size.x(),
+                               (iy+0.5)*fCellSize.y() - 0.5*size.y(),
+                               (iz+0.5)*fCellSize.z() - 0.5*size.z());
+        fCell[cell] = new G4PVPlacement(0, position, fCellL, "WindowCell",
+                                        meshL, false, cell);
+      }
+    }
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void WeightWindowWorld::ConstructSD()
+{
+  if (!fCellL) return;
+
+  WeightWindowSD* windowSD = new WeightWindowSD("WeightWindowSD");
+  G4SDManager::GetSDMpointer()->AddNewDetector(windowSD);
+  SetSensitiveDetector(fCellL, windowSD);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool WeightWindowWorld::LoadWindows(const G4String& fileName)
+{
+  if (!HasMesh()) {
+    G4cout << "\n--> warning from WeightWindowWorld::LoadWindows : "
+           << "no weight-window mesh, set it first" << G4endl;
+    return false;
+  }
+
+  std::ifstream file(fileName);
+  if (!file) {
+    G4cout << "\n--> warning from WeightWindowWorld::LoadWindows : "
+           << "cannot open " << fileName << G4endl;
+    return false;
+  }
+
+  const G4int nbGroups = WindowFluxTally::kNbGroups;
+  std::vector<G4double> lowerWeight(GetNbCells()*nbGroups, 0.);
+  std::vector<G4bool> read(GetNbCells(), false);
+  G4int nbRead = 0;
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty()) continue;
+    if (line[0] == '#') {
+      // the mesh of the file must be the current one
+      size_t pos = line.find("cells:");
+      if (pos == std::string::npos) continue;
+      std::istringstream is(line.substr(pos+6));
+      G4int n[3] = { 0, 0, 0 };
+      is >> n[0] >> n[1] >> n[2];
+      if (n[0] != fNbCells[0] || n[1] != fNbCells[1] || n[2] != fNbCells[2]) {
+        G4cout << "\n--> warning from WeightWindowWorld::LoadWindows : "
+               << fileName << " has " << n[0] << "x" << n[1] << "x" << n[2]
+               << " cells, the mesh " << fNbCells[0] << "x" << fNbCells[1]
+               << "x" << fNbCells[2] << "; windows not loaded" << G4endl;
+        return false;
+      }
+      continue;
+    }
+    std::replace(line.begin(), line.end(), ',', ' ');
+    std::istringstream is(line);
+    G4int ix, iy, iz;
+    if (!(is >> ix >> iy >> iz)) continue;
+    if (ix < 0 || ix >= fNbCells[0] || iy < 0 || iy >= fNbCells[1]
+        || iz < 0 || iz >= fNbCells[2]) continue;
+    G4int cell = (ix*fNbCells[1] + iy)*fNbCells[2] + iz;
+    if (read[cell]) {
+      G4cout << "\n--> warning from WeightWindowWorld::LoadWindows : "
+             << fileName << " has cell " << ix << "," << iy << "," << iz
+             << " twice; windows not loaded" << G4endl;
+      return false;
+    }
+    for (G4int g=0; g<nbGroups; ++g) {
+      G4double& wl = lowerWeight[cell*nbGroups + g];
+      if (!(is >> wl) || wl <= 0.) {
+        G4cout << "\n--> warning from WeightWindowWorld::LoadWindows : "
+               << fileName << ", cell " << ix << "," << iy << "," << iz
+               << ": " << nbGroups << " positive lower weights expected;"
+               << " windows not loaded" << G4endl;
+        return false;
+      }
+    }
+    read[cell] = true;
+    ++nbRead;
+  }
+
+  if (nbRead != GetNbCells()) {
+    G4cout << "\n--> warning from WeightWindowWorld::LoadWindows : "
+           << fileName << " has " << nbRead << " of " << GetNbCells()
+           << " cells; windows not loaded" << G4endl;
+    return false;
+  }
+  fLowerWeight = lowerWeight;
+  G4cout << "\n Weight windows of " << nbRead << " cells read from "
+         << fileName << G4endl;
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4bool WeightWindowWorld::WriteWindows(const G4String& fileName,
+                                       const std::vector<G4double>& lowerWeight) const
+{
+  std::ofstream file(fileName);
+  if (!file) {
+    G4cout << "\n--> warning from WeightWindowWorld::WriteWindows : "
+           << "cannot open " << fileName << G4endl;
+    return false;
+  }
+
+  const G4int nbGroups = WindowFluxTally::kNbGroups;
+  file << "# weight windows: lower weight bounds of neutrons\n";
+  file << "# cells: " << fNbCells[0] << " " << fNbCells[1] << " "
+       << fNbCells[2] << "\n";
+  file << "# origin [cm]: " << fOrigin.x()/cm << " " << fOrigin.y()/cm
+       << " " << fOrigin.z()/cm << "\n";
+  file << "# cell size [cm]: " << fCellSize.x()/cm << " "
+       << fCellSize.y()/cm << " " << fCellSize.z()/cm << "\n";
+  file << "# energy groups, upper bounds [MeV]:";
+  for (G4int g=0; g<nbGroups-1; ++g) file << " " << WindowFluxTally::GetGroupBound(g)/MeV;
+  file << " inf\n";
+  file << "# survival factor: " << fSurvivalFactor << "\n";
+  file << "# ix,iy,iz,wl[group]\n";
+
+  file.precision(6);
+  for (G4int ix=0; ix<fNbCells[0]; ++ix) {
+    for (G4int iy=0; iy<fNbCells[1]; ++iy) {
+      for (G4int iz=0; iz<fNbCells[2]; ++iz) {
+        G4int cell = (ix*fNbCells[1] + iy)*fNbCells[2] + iz;
+        file << ix << "," << iy << "," << iz;
+        for (G4int g=0; g<nbGroups; ++g) file << "," << lowerWeight[cell*nbGroups + g];
+        file << "\n";
+      }
+    }
+  }
+  return file.good();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void WeightWindowWorld::GenerateWindows(const WindowFluxTally& flux)
+{
+  if (!flux.IsBooked()) return;
+
+  // reference: the largest fluence of the source (fast) group
+  const G4int nbGroups = WindowFluxTally::kNbGroups;
+  G4int nbCells = flux.GetNbCells();
+  G4double reference = 0.;
+  for (G4int c=0; c<nbCells; ++c) {
+    reference = std::max(reference, flux.GetFlux(c, nbGroups-1));
+  }
+  if (reference <= 0.) {
+    G4cout << "\n--> warning from WeightWindowWorld::GenerateWindows : "
+           << "no neutron fluence scored, no windows written" << G4endl;
+    return;
+  }
+
+  // cells not reached by the pilot run get the smallest window
+  std::vector<G4double> lowerWeight(nbCells*nbGroups, 0.);
+  G4double wlMin = DBL_MAX;
+  G4int nbEmpty = 0;
+  for (G4int c=0; c<nbCells; ++c) {
+    for (G4int g=0; g<nbGroups; ++g) {
+      G4double wl = flux.GetFlux(c, g)/reference/fSurvivalFactor;
+      lowerWeight[c*nbGroups + g] = wl;
+      if (wl > 0.) wlMin = std::min(wlMin, wl);
+      else         ++nbEmpty;
+    }
+  }
+  for (size_t i=0; i<lowerWeight.size(); ++i) {
+    if (lowerWeight[i] == 0.) lowerWeight[i] = wlMin;
+  }
+
+  if (WriteWindows(fGenerationFile, lowerWeight)) {
+    G4cout << "\n Weight windows written to " << fGenerationFile
+           << " (" << nbEmpty << " of " << nbCells*nbGroups
+           << " cell-groups not reached, smallest wl = " << wlMin << ")."
+           << "\n Load them with /testhadr/bias/ww/load before /run/initialize"
+           << G4endl;
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void WeightWindowWorld::UpdateWindowStore()
+{
+  if (!HasWindows() || !fWorldP) return;
+
+  G4WeightWindowStore* store = G4WeightWindowStore::GetInstance(GetName());
+
+  // the windows are fixed once the run is initialized: set them once
+  G4GeometryCell worldCell(*fWorldP, 0);
+  if (store->IsKnown(worldCell)) return;
+
+  const G4int nbGroups = WindowFluxTally::kNbGroups;
+  G4double wlMin = *std::min_element(fLowerWeight.begin(), fLowerWeight.end());
+
+  // outside the mesh nothing is rouletted: the smallest window
+  G4UpperEnergyToLowerWeightMap outside;
+  for (G4int g=0; g<nbGroups; ++g) outside[WindowFluxTally::GetGroupBound(g)] = wlMin;
+  store->AddUpperEboundLowerWeightPairs(worldCell, outside);
+  store->AddUpperEboundLowerWeightPairs(G4GeometryCell(*fMeshP, 0), outside);
+
+  for (G4int c=0; c<GetNbCells(); ++c) {
+    G4UpperEnergyToLowerWeightMap windows;
+    for (G4int g=0; g<nbGroups; ++g) {
+      windows[WindowFluxTally::GetGroupBound(g)] = fLowerWeight[c*nbGroups + g];
+    }
+    store->AddUpperEboundLowerWeightPairs(G4GeometryCell(*fCell[c], c), windows);
+  }
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
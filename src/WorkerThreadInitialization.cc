@@ -0,0 +1,79 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+//
+/// \file WorkerThreadInitialization.cc
+/// \brief Implementation of the WorkerThreadInitialization class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "WorkerThreadInitialization.hh"
+
+#ifdef G4MULTITHREADED
+
+#include "ThreadAffinity.hh"
+#include "NodeWorkerRunManager.hh"
+
+#include "G4Threading.hh"
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+WorkerThreadInitialization::WorkerThreadInitialization(const G4String& policy,
+                                                       G4int nbThreads)
+  : G4UserWorkerThreadInitialization(), fAffinity(0), fMerger(0)
+{
+  // no policy: threads left to the scheduler, flat merge
+  if (policy.empty() || policy == "none") return;
+  fAffinity = new ThreadAffinity(policy);
+  fAffinity->Print(nbThreads);
+  fMerger = new NodeMerger(fAffinity);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+WorkerThreadInitialization::~WorkerThreadInitialization()
+{
+  delete fMerger;
+  delete fAffinity;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+G4WorkerRunManager* WorkerThreadInitialization::CreateWorkerRunManager() const
+{
+  G4int thread = G4Threading::G4GetThreadId();
+  if (fAffinity && fAffinity->IsValid() && !fAffinity->Pin(thread)) {
+    G4cout << "\n--> warning from WorkerThreadInitialization : thread "
+           << thread << " not pinned to cpu " << fAffinity->GetCpu(thread)
+           << G4endl;
+  }
+  return new NodeWorkerRunManager(fMerger);
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,139 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file CrossingFile.cc
+/// \brief Implementation of the CrossingFile class
+//
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "CrossingFile.hh"
+
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CrossingFile::CrossingFile()
+  : fData(0), fSize(0), fNbRows(0)
+{ }
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CrossingFile::~CrossingFile()
+{
+  Close();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+bool CrossingFile::Fail(const std::string& error)
+{
+  Close();
+  fError = error;
+  return false;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+bool CrossingFile::Open(const std::string& fileName)
+{
+  using namespace CrossingFormat;
+  Close();
+
+  int fd = ::open(fileName.c_str(), O_RDONLY);
+  if (fd < 0) return Fail("cannot open " + fileName);
+  struct stat st;
+  if (::fstat(fd, &st) != 0) { ::close(fd); return Fail("cannot stat " + fileName); }
+  fSize = st.st_size;
+  if (fSize < sizeof(FileHeader)) { ::close(fd); return Fail(fileName + " is too short"); }
+
+  void* data = ::mmap(0, fSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) { fData = 0; return Fail("cannot map " + fileName); }
+  fData = static_cast<const char*>(data);
+  ::madvise(data, fSize, MADV_SEQUENTIAL);
+
+  // header
+  const FileHeader* header = reinterpret_cast<const FileHeader*>(fData);
+  if (std::memcmp(header->magic, kMagic, sizeof(kMagic)) != 0)
+    return Fail(fileName + " is not a crossing file");
+  if (header->version != kVersion || header->nbColumns != kNbColumns)
+    return Fail(fileName + " has an unsupported version");
+
+  // index the chunks; a truncated last chunk (crashed run) is ignored
+  size_t offset = sizeof(FileHeader);
+  while (offset + sizeof(ChunkHeader) <= fSize) {
+    const ChunkHeader* chunk = reinterpret_cast<const ChunkHeader*>(fData + offset);
+    if (chunk->magic != kChunkMagic ||
+        chunk->nbBytes != ChunkBytes(chunk->nbRows)) {
+      return Fail(fileName + " has a corrupted chunk");
+    }
+    if (offset + chunk->nbBytes > fSize) break;
+    fChunks.push_back(offset);
+    fNbRows += chunk->nbRows;
+    offset += chunk->nbBytes;
+  }
+  return true;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+void CrossingFile::Close()
+{
+  if (fData) ::munmap(const_cast<char*>(fData), fSize);
+  fData = 0;
+  fSize = 0;
+  fChunks.clear();
+  fNbRows = 0;
+  fError.clear();
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+CrossingFile::Chunk CrossingFile::GetChunk(size_t i) const
+{
+  using namespace CrossingFormat;
+
+  const char* base = fData + fChunks[i];
+  size_t n = reinterpret_cast<const ChunkHeader*>(base)->nbRows;
+
+  Chunk chunk;
+  chunk.nbRows   = n;
+  chunk.x        = reinterpret_cast<const float*>(base + ColumnOffset(kX, n));
+  chunk.y        = reinterpret_cast<const float*>(base + ColumnOffset(kY, n));
+  chunk.z        = reinterpret_cast<const float*>(base + ColumnOffset(kZ, n));
+  chunk.energy   = reinterpret_cast<const float*>(base + ColumnOffset(kEnergy, n));
+  chunk.weight   = reinterpret_cast<const float*>(base + ColumnOffset(kWeight, n));
+  chunk.event    = reinterpret_cast<const int32_t*>(base + ColumnOffset(kEvent, n));
+  chunk.particle = reinterpret_cast<const uint8_t*>(base + ColumnOffset(kParticle, n));
+  return chunk;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
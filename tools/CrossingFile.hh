@@ -0,0 +1,100 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file CrossingFile.hh
+/// \brief Definition of the CrossingFile class
+//
+// Read-only access to a binary columnar crossing file written by Monitor
+// (/testhadr/output/crossings binary). The file is memory-mapped and each
+// chunk exposes its columns as plain arrays, so that scans run at memory
+// bandwidth:
+//
+//   CrossingFile file;
+//   if (!file.Open("BoratedPoly_crossings.bin")) { ... file.GetError() ... }
+//   for (size_t c=0; c<file.GetNbChunks(); ++c) {
+//     CrossingFile::Chunk chunk = file.GetChunk(c);
+//     for (size_t i=0; i<chunk.nbRows; ++i) sum += chunk.weight[i];
+//   }
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#ifndef CrossingFile_h
+#define CrossingFile_h 1
+
+#include "CrossingFormat.hh"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+class CrossingFile
+{
+  public:
+    struct Chunk {
+      size_t         nbRows;
+      const float*   x;
+      const float*   y;
+      const float*   z;
+      const float*   energy;       // [MeV]
+      const float*   weight;
+      const int32_t* event;
+      const uint8_t* particle;     // 0 neutron, 1 gamma
+    };
+
+  public:
+    CrossingFile();
+   ~CrossingFile();
+
+    // map the file and index its chunks; false on error (see GetError)
+    bool Open(const std::string& fileName);
+    void Close();
+
+    size_t GetNbChunks() const { return fChunks.size(); };
+    size_t GetNbRows() const   { return fNbRows; };
+    size_t GetNbBytes() const  { return fSize; };
+    Chunk  GetChunk(size_t i) const;
+
+    const std::string& GetError() const { return fError; };
+
+  private:
+    CrossingFile(const CrossingFile&);
+    CrossingFile& operator=(const CrossingFile&);
+
+    bool Fail(const std::string& error);
+
+    const char*         fData;
+    size_t              fSize;
+    std::vector<size_t> fChunks;     // offsets of the chunk headers
+    size_t              fNbRows;
+    std::string         fError;
+};
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#endif
@@ -0,0 +1,94 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file crossing2root.cc
+/// \brief Conversion of a binary crossing file to ROOT ntuples
+//
+// Usage: crossing2root file.bin out.root
+// Writes the nFlux and gFlux trees with the columns of the default
+// (double) schema, x,y,z [m] and KE|E [MeV], plus the weight w and the
+// event ID, so that the ROOT macros of Monitor read them unchanged.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "CrossingFile.hh"
+
+#include "TFile.h"
+#include "TTree.h"
+
+#include <cstdio>
+#include <string>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int main(int argc, char** argv)
+{
+  if (argc != 3) {
+    std::fprintf(stderr, "usage: %s file.bin out.root\n", argv[0]);
+    return 1;
+  }
+
+  CrossingFile file;
+  if (!file.Open(argv[1])) {
+    std::fprintf(stderr, "%s\n", file.GetError().c_str());
+    return 1;
+  }
+
+  TFile out(argv[2], "RECREATE");
+  if (out.IsZombie()) return 1;
+
+  Double_t x, y, z, energy, weight;
+  Int_t    event;
+  TTree* trees[2] = { new TTree("nFlux", "Neutrons hitting lab walls"),
+                      new TTree("gFlux", "Gammas hitting lab walls") };
+  const char* energyName[2] = { "KE", "E" };
+  for (int p=0; p<2; ++p) {
+    trees[p]->Branch("x", &x, "x/D");
+    trees[p]->Branch("y", &y, "y/D");
+    trees[p]->Branch("z", &z, "z/D");
+    trees[p]->Branch(energyName[p], &energy, (std::string(energyName[p])+"/D").c_str());
+    trees[p]->Branch("w", &weight, "w/D");
+    trees[p]->Branch("event", &event, "event/I");
+  }
+
+  for (size_t c=0; c<file.GetNbChunks(); ++c) {
+    CrossingFile::Chunk chunk = file.GetChunk(c);
+    for (size_t i=0; i<chunk.nbRows; ++i) {
+      x = chunk.x[i]; y = chunk.y[i]; z = chunk.z[i];
+      energy = chunk.energy[i];
+      weight = chunk.weight[i];
+      event  = chunk.event[i];
+      trees[chunk.particle[i] & 1]->Fill();
+    }
+  }
+
+  out.Write();
+  out.Close();
+  std::printf(" %zu crossings converted to %s\n", file.GetNbRows(), argv[2]);
+  return 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
@@ -0,0 +1,83 @@
+//
+// ********************************************************************
+// * License and Disclaimer                                           *
+// *                                                                  *
+// * The  Geant4 software  is  copyright of the Copyright Holders  of *
+// * the Geant4 Collaboration.  It is provided  under  the terms  and *
+// * conditions of the Geant4 Software License,  included in the file *
+// * LICENSE and available at  http://cern.ch/geant4/license .  These *
+// * include a list of copyright holders.                             *
+// *                                                                  *
+// * Neither the authors of this software system, nor their employing *
+// * institutes,nor the agencies providing financial support for this *
+// * work  make  any representation or  warranty, express or implied, *
+// * regarding  this  software system or assume any liability for its *
+// * use.  Please see the license in the file  LICENSE  and URL above *
+// * for the full disclaimer and the limitation of liability.         *
+// *                                                                  *
+// * This  code  implementation is the result of  the  scientific and *
+// * technical work of the GEANT4 collaboration.                      *
+// * By using,  copying,  modifying or  distributing the software (or *
+// * any work based  on the software)  you  agree  to acknowledge its *
+// * use  in  resulting  scientific  publications,  and indicate your *
+// * acceptance of all terms of the Geant4 Software license.          *
+// ********************************************************************
+//
+/// \file crossingScan.cc
+/// \brief Summary of a binary crossing file, with optional energy cut
+//
+// Usage: crossingScan file.bin [Emin Emax]   (energies in MeV)
+// Prints the number of crossings and their summed weight per particle,
+// and the scan throughput.
+//
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+#include "CrossingFile.hh"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......
+
+int main(int argc, char** argv)
+{
+  if (argc != 2 && argc != 4) {
+    std::fprintf(stderr, "usage: %s file.bin [Emin Emax]\n", argv[0]);
+    return 1;
+  }
+  float emin = (argc == 4) ? std::atof(argv[2]) : 0.f;
+  float emax = (argc == 4) ? std::atof(argv[3]) : 1.e30f;
+
+  CrossingFile file;
+  if (!file.Open(argv[1])) {
+    std::fprintf(stderr, "%s\n", file.GetError().c_str());
+    return 1;
+  }
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  double count[2]  = { 0., 0. };
+  double weight[2] = { 0., 0. };
+  for (size_t c=0; c<file.GetNbChunks(); ++c) {
+    CrossingFile::Chunk chunk = file.GetChunk(c);
+    for (size_t i=0; i<chunk.nbRows; ++i) {
+      bool pass = chunk.energy[i] >= emin && chunk.energy[i] < emax;
+      int  p    = chunk.particle[i] & 1;
+      count[p]  += pass;
+      weight[p] += pass ? chunk.weight[i] : 0.f;
+    }
+  }
+  double seconds = std::chrono::duration<double>(
+                     std::chrono::steady_clock::now() - start).count();
+
+  std::printf(" %s : %zu crossings in %zu chunks\n",
+              argv[1], file.GetNbRows(), file.GetNbChunks());
+  std::printf("   neutrons : %12.0f  (sum of weights %g)\n", count[0], weight[0]);
+  std::printf("   gammas   : %12.0f  (sum of weights %g)\n", count[1], weight[1]);
+  std::printf("   scanned in %g s (%g GB/s)\n", seconds,
+              seconds > 0. ? 1.e-9*file.GetNbBytes()/seconds : 0.);
+  return 0;
+}
+
+//....oooOO0OOooo........oooOO0OOooo........oooOO0OOooo........oooOO0OOooo......